@@ -0,0 +1,146 @@
+// main.cpp — headless benchmark harness and regression gate.
+//
+// Runs each scene for a fixed frame count (optionally driving input from a
+// captured trace) and reports frame-time percentiles as one JSON object
+// per scene on stdout, so release gates can diff runs mechanically.
+//
+// Usage: iui_bench [--scene NAME] [--frames N] [--trace FILE.iuit]
+//                  [--threads N]
+
+#include "scenes.h"
+
+#include "iui/trace.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+uint64_t now_us() {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+uint64_t percentile(std::vector<uint64_t> &sorted, double p) {
+    if (sorted.empty())
+        return 0;
+    size_t i = (size_t)(p * (double)(sorted.size() - 1) + 0.5);
+    return sorted[i];
+}
+
+// Feed trace events for one frame (up to the next frame mark) into the
+// scene's context: moves hit-test, everything else is decoded and dropped,
+// which matches what the replay CI measures — input handling cost, not app
+// logic.
+void replay_frame_events(iui_trace_reader *trace, bench::scene_ctx &s) {
+    const iui_event *e;
+    while ((e = iui_trace_next(trace)) != nullptr) {
+        if (e->type == IUI_EVENT_FRAME_MARK)
+            return;
+        if (e->type == IUI_EVENT_MOUSE_MOVE ||
+            e->type == IUI_EVENT_TOUCH_MOVE)
+            iui_hit_test(s.ui, e->x, e->y);
+    }
+}
+
+int run_scene(const bench::scene &sc, uint64_t frames,
+              iui_trace_reader *trace) {
+    bench::scene_ctx s{};
+    s.ui = iui_context_create();
+    s.text = iui_text_create(1024, 1024);
+    s.font = iui_text_register_font(s.text, nullptr);
+    s.width = 1920.0f;
+    s.height = 1080.0f;
+    if (!s.ui || !s.text) {
+        fprintf(stderr, "error: context creation failed\n");
+        return 1;
+    }
+    if (trace)
+        iui_trace_rewind(trace);
+
+    std::vector<uint64_t> samples;
+    samples.reserve(frames);
+    for (uint64_t f = 0; f < frames; ++f) {
+        uint64_t t0 = now_us();
+        sc.declare(s, f);
+        if (trace)
+            replay_frame_events(trace, s);
+        samples.push_back(now_us() - t0);
+    }
+
+    std::sort(samples.begin(), samples.end());
+    uint64_t sum = 0;
+    for (uint64_t v : samples)
+        sum += v;
+    printf("{\"scene\":\"%s\",\"frames\":%llu,\"widgets\":%u,"
+           "\"mean_us\":%llu,\"p50_us\":%llu,\"p90_us\":%llu,"
+           "\"p99_us\":%llu,\"max_us\":%llu}\n",
+           sc.name, (unsigned long long)frames, iui_widget_count(s.ui),
+           (unsigned long long)(sum / frames),
+           (unsigned long long)percentile(samples, 0.50),
+           (unsigned long long)percentile(samples, 0.90),
+           (unsigned long long)percentile(samples, 0.99),
+           (unsigned long long)samples.back());
+
+    iui_text_destroy(s.text);
+    iui_context_destroy(s.ui);
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    const char *scene_name = nullptr;
+    const char *trace_path = nullptr;
+    uint64_t frames = 200;
+    for (int i = 1; i < argc; ++i) {
+        if (!strcmp(argv[i], "--scene") && i + 1 < argc) {
+            scene_name = argv[++i];
+        } else if (!strcmp(argv[i], "--frames") && i + 1 < argc) {
+            frames = (uint64_t)strtoull(argv[++i], nullptr, 10);
+        } else if (!strcmp(argv[i], "--trace") && i + 1 < argc) {
+            trace_path = argv[++i];
+        } else if (!strcmp(argv[i], "--threads") && i + 1 < argc) {
+            iui_set_worker_threads(
+                (uint32_t)strtoul(argv[++i], nullptr, 10));
+        } else {
+            fprintf(stderr,
+                    "usage: %s [--scene NAME] [--frames N] "
+                    "[--trace FILE.iuit] [--threads N]\n",
+                    argv[0]);
+            return 2;
+        }
+    }
+    if (frames == 0)
+        frames = 1;
+
+    iui_trace_reader *trace = nullptr;
+    if (trace_path) {
+        trace = iui_trace_open(trace_path);
+        if (!trace) {
+            fprintf(stderr, "error: cannot open trace %s\n", trace_path);
+            return 1;
+        }
+    }
+
+    int rc = 0;
+    bool matched = false;
+    for (const bench::scene *sc = bench::all_scenes(); sc->name; ++sc) {
+        if (scene_name && strcmp(scene_name, sc->name) != 0)
+            continue;
+        matched = true;
+        rc |= run_scene(*sc, frames, trace);
+    }
+    if (!matched) {
+        fprintf(stderr, "error: unknown scene %s\n", scene_name);
+        rc = 2;
+    }
+    if (trace)
+        iui_trace_close(trace);
+    return rc;
+}
@@ -0,0 +1,108 @@
+// scenes.cpp — scene definitions; see scenes.h.
+
+#include "scenes.h"
+
+#include "iui/damage.h"
+
+#include <cstdio>
+
+namespace bench {
+
+namespace {
+
+// ~40k widgets across 200 panels: the production dashboard-wall shape.
+void widget_storm(scene_ctx &s, uint64_t frame) {
+    char id[32];
+    iui_frame_begin(s.ui, s.width, s.height);
+    for (int p = 0; p < 200; ++p) {
+        snprintf(id, sizeof(id), "panel%d", p);
+        iui_widget_begin(s.ui, id);
+        iui_widget_set_axis(s.ui, IUI_AXIS_COLUMN);
+        for (int r = 0; r < 199; ++r) {
+            snprintf(id, sizeof(id), "cell%d", r);
+            iui_widget_begin(s.ui, id);
+            iui_widget_set_size(s.ui, IUI_SIZE_FILL, 4.0f);
+            // One panel ticks per frame, the rest are static — the damage
+            // engine should skip 199 of 200 subtrees.
+            if ((uint64_t)p == frame % 200)
+                iui_widget_set_content_hash(s.ui, frame);
+            iui_widget_end(s.ui);
+        }
+        iui_widget_end(s.ui);
+    }
+    iui_frame_end(s.ui);
+}
+
+// 1000-deep single chain: stresses per-level overhead.
+void deep_nesting(scene_ctx &s, uint64_t) {
+    char id[32];
+    iui_frame_begin(s.ui, s.width, s.height);
+    for (int d = 0; d < 1000; ++d) {
+        snprintf(id, sizeof(id), "n%d", d);
+        iui_widget_begin(s.ui, id);
+        iui_widget_set_padding(s.ui, 0.25f);
+    }
+    for (int d = 0; d < 1000; ++d)
+        iui_widget_end(s.ui);
+    iui_frame_end(s.ui);
+}
+
+// Log-tail view: thousands of distinct lines shaped through the run cache.
+void text_heavy(scene_ctx &s, uint64_t frame) {
+    char id[32], line[96];
+    iui_frame_begin(s.ui, s.width, s.height);
+    iui_widget_begin(s.ui, "log");
+    iui_widget_set_axis(s.ui, IUI_AXIS_COLUMN);
+    for (int r = 0; r < 2000; ++r) {
+        snprintf(id, sizeof(id), "line%d", r);
+        // A tailing log: line content shifts by one row per frame, so all
+        // but the newest line hit the shaped-run cache.
+        snprintf(line, sizeof(line),
+                 "2026-08-31 12:00:%02d service=feed seq=%llu level=info "
+                 "latency_ms=%d",
+                 r % 60, (unsigned long long)(frame + (uint64_t)r), r % 17);
+        const iui_shaped_run *run = iui_text_shape(s.text, s.font, line, 0);
+        iui_widget_begin(s.ui, id);
+        iui_widget_set_size(s.ui, IUI_SIZE_FILL, run ? run->height : 13.0f);
+        iui_widget_set_content_hash(s.ui, frame + (uint64_t)r);
+        iui_widget_end(s.ui);
+    }
+    iui_widget_end(s.ui);
+    iui_frame_end(s.ui);
+    iui_text_frame(s.text);
+}
+
+// Fast scroll: every row's position changes every frame, worst case for
+// damage tracking and layout caching.
+void scroll_stress(scene_ctx &s, uint64_t frame) {
+    char id[32];
+    float offset = (float)(frame % 40);
+    iui_frame_begin(s.ui, s.width, s.height);
+    iui_widget_begin(s.ui, "pane");
+    iui_widget_set_axis(s.ui, IUI_AXIS_COLUMN);
+    iui_widget_set_padding(s.ui, -offset); // crude scroll via padding shift
+    for (int r = 0; r < 5000; ++r) {
+        snprintf(id, sizeof(id), "row%d", r);
+        iui_widget_begin(s.ui, id);
+        iui_widget_set_size(s.ui, IUI_SIZE_FILL, 18.0f);
+        iui_widget_end(s.ui);
+    }
+    iui_widget_end(s.ui);
+    iui_frame_end(s.ui);
+}
+
+const scene kScenes[] = {
+    {"widget_storm", widget_storm},
+    {"deep_nesting", deep_nesting},
+    {"text_heavy", text_heavy},
+    {"scroll_stress", scroll_stress},
+    {nullptr, nullptr},
+};
+
+} // namespace
+
+const scene *all_scenes() {
+    return kScenes;
+}
+
+} // namespace bench
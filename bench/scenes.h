@@ -0,0 +1,38 @@
+// scenes.h — representative benchmark scenes.
+//
+// Each scene declares one frame through the public API, parameterized by
+// the frame index so animated scenes actually change.  Scenes are the
+// workloads we regress against: widget storm (wide dashboards), deep
+// nesting (pathological hierarchies), text heavy (log/table views) and
+// scroll stress (damage and cache churn).
+#ifndef IUI_BENCH_SCENES_H
+#define IUI_BENCH_SCENES_H
+
+#include "iui/iui.h"
+#include "iui/text.h"
+
+#include <cstdint>
+
+namespace bench {
+
+struct scene_ctx {
+    iui_context *ui;
+    iui_text_system *text;
+    iui_font font;
+    float width;
+    float height;
+};
+
+using scene_fn = void (*)(scene_ctx &, uint64_t frame);
+
+struct scene {
+    const char *name;
+    scene_fn declare;
+};
+
+// NULL-name terminated.
+const scene *all_scenes();
+
+} // namespace bench
+
+#endif // IUI_BENCH_SCENES_H
@@ -0,0 +1,58 @@
+/* anim.h — native animation timelines over the widget store.
+ *
+ * Tweening in Lua costs a table walk and an FFI-boundary crossing per
+ * property per frame; a few hundred concurrent animations burn
+ * milliseconds before any real work.  Here the script registers a
+ * timeline once — target slot, property, endpoints, duration, curve —
+ * and the core advances every active timeline in one flat pass at
+ * iui_frame_begin, writing results straight into the SoA store columns.
+ * Script code starts and stops animations; it never steps them.
+ *
+ * Animated scroll offsets land before layout runs, so a scroll animation
+ * moves content the same frame with no script involvement at all.
+ */
+#ifndef IUI_ANIM_H
+#define IUI_ANIM_H
+
+#include "iui/store.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum iui_anim_prop {
+    IUI_ANIM_VALUE = 0,    /* the store's free animation lane */
+    IUI_ANIM_SCROLL_X = 1, /* consumed by layout, like slot_set_scroll */
+    IUI_ANIM_SCROLL_Y = 2,
+    IUI_ANIM_PROP_COUNT = 3,
+} iui_anim_prop;
+
+typedef enum iui_anim_curve {
+    IUI_CURVE_LINEAR = 0,
+    IUI_CURVE_EASE_IN = 1,     /* t^2 */
+    IUI_CURVE_EASE_OUT = 2,    /* 1 - (1-t)^2 */
+    IUI_CURVE_EASE_IN_OUT = 3, /* smoothstep */
+} iui_anim_curve;
+
+/* Start (or restart) the timeline for (slot, prop); one timeline per
+ * pair, a second start replaces the first.  duration_ms <= 0 applies the
+ * end value immediately. */
+IUI_API iui_status iui_anim_start(iui_context *ctx, iui_slot slot,
+                                  iui_anim_prop prop, float from, float to,
+                                  float duration_ms, iui_anim_curve curve);
+
+/* Stop the timeline, leaving the property at its current value. */
+IUI_API iui_status iui_anim_stop(iui_context *ctx, iui_slot slot,
+                                 iui_anim_prop prop);
+
+/* Timelines still running. */
+IUI_API uint32_t iui_anim_active(const iui_context *ctx);
+
+/* Current value of the free animation lane for a slot. */
+IUI_API float iui_slot_anim_value(const iui_context *ctx, iui_slot slot);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* IUI_ANIM_H */
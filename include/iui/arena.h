@@ -0,0 +1,52 @@
+/* arena.h — bump allocators for per-frame transient data.
+ *
+ * Widget descriptors, label text and layout scratch are alive for exactly
+ * one frame, so they come out of an arena that is reset wholesale instead
+ * of being freed piecemeal — no per-widget malloc, nothing for the LuaJIT
+ * GC to trace.  The Lua side allocates through the FFI and gets plain
+ * pointers it may hold until the next iui_frame_begin.
+ *
+ * Standalone arenas are also available for longer-lived phases (scene
+ * building, trace decode) with an explicit reset.
+ */
+#ifndef IUI_ARENA_H
+#define IUI_ARENA_H
+
+#include "iui/iui.h"
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct iui_arena iui_arena;
+
+/* block_size is the granularity the arena grows by; 0 picks a default. */
+IUI_API iui_arena *iui_arena_create(size_t block_size);
+IUI_API void iui_arena_destroy(iui_arena *a);
+
+/* Aligned bump allocation; align must be a power of two (0 = 16).
+ * Returns NULL only when the system allocator fails. */
+IUI_API void *iui_arena_alloc(iui_arena *a, size_t size, size_t align);
+
+/* Copy a NUL-terminated string into the arena. */
+IUI_API char *iui_arena_strdup(iui_arena *a, const char *s);
+
+/* Drop everything at once.  Retains the largest block for reuse, so a
+ * steady-state frame performs no system allocation at all. */
+IUI_API void iui_arena_reset(iui_arena *a);
+
+IUI_API size_t iui_arena_used(const iui_arena *a);
+
+/* The context's frame arena: reset automatically by iui_frame_begin.
+ * Allocations survive until the next frame begins — long enough for the
+ * renderer to consume the frame they describe. */
+IUI_API void *iui_frame_alloc(iui_context *ctx, size_t size, size_t align);
+IUI_API char *iui_frame_strdup(iui_context *ctx, const char *s);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* IUI_ARENA_H */
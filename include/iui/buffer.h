@@ -0,0 +1,59 @@
+/* buffer.h — zero-copy bulk-transfer buffers, clipboard and drag-and-drop.
+ *
+ * A iui_buffer is a reference-counted byte region visible from both sides
+ * of the FFI: Lua gets the raw pointer from iui_buffer_data and writes the
+ * payload in place, then hands the handle to the clipboard or DnD channel
+ * — no round trip through Lua strings, no copies.  Buffers can also wrap
+ * externally owned memory (a mapped bundle entry, a decoded image) with a
+ * release callback.
+ *
+ * Channels hold one buffer per MIME type and take their own reference;
+ * a 50 MB table selection costs one allocation and zero copies end to end
+ * until the OS integration layer actually exports it.
+ */
+#ifndef IUI_BUFFER_H
+#define IUI_BUFFER_H
+
+#include "iui/iui.h"
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct iui_buffer iui_buffer;
+
+/* New zeroed buffer with refcount 1. */
+IUI_API iui_buffer *iui_buffer_create(size_t size);
+
+/* Wrap external memory; release(user, data) fires when the last reference
+ * drops.  release may be NULL for memory that outlives all users. */
+IUI_API iui_buffer *iui_buffer_wrap(void *data, size_t size,
+                                    void (*release)(void *user, void *data),
+                                    void *user);
+
+IUI_API void *iui_buffer_data(iui_buffer *b);
+IUI_API size_t iui_buffer_size(const iui_buffer *b);
+
+IUI_API void iui_buffer_ref(iui_buffer *b);
+IUI_API void iui_buffer_unref(iui_buffer *b);
+
+/* Clipboard: one buffer per MIME type, replacing any previous entry.  The
+ * channel takes its own reference; get returns a new reference the caller
+ * must unref. */
+IUI_API iui_status iui_clipboard_set(iui_context *ctx, const char *mime,
+                                     iui_buffer *b);
+IUI_API iui_buffer *iui_clipboard_get(iui_context *ctx, const char *mime);
+
+/* Drag and drop: same contract, scoped between begin and end. */
+IUI_API iui_status iui_dnd_begin(iui_context *ctx, const char *mime,
+                                 iui_buffer *b);
+IUI_API iui_buffer *iui_dnd_payload(iui_context *ctx, const char *mime);
+IUI_API void iui_dnd_end(iui_context *ctx);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* IUI_BUFFER_H */
@@ -0,0 +1,70 @@
+/* bundle.h — memory-mapped, zero-extraction application bundles.
+ *
+ * Replaces the Software-*.zip archives: a bundle is a single seekable file
+ * the launcher maps once and reads in place.  Every entry's payload starts
+ * on a page boundary, so DLLs and bytecode can be loaded or executed
+ * straight out of the mapping — no temp directory, no up-front
+ * decompression, startup cost is the page faults actually touched.
+ *
+ * On-disk layout (little-endian):
+ *   iui_bundle_header
+ *   iui_bundle_entry[entry_count]
+ *   name blob (NUL-terminated strings, offsets from file start)
+ *   entry payloads, each aligned to IUI_BUNDLE_PAGE
+ */
+#ifndef IUI_BUNDLE_H
+#define IUI_BUNDLE_H
+
+#include "iui/iui.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define IUI_BUNDLE_MAGIC 0x42495549u /* "IUIB" */
+#define IUI_BUNDLE_VERSION 1u
+#define IUI_BUNDLE_PAGE 4096u
+
+typedef struct iui_bundle_header {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t entry_count;
+    uint32_t reserved;
+    uint64_t file_size;
+} iui_bundle_header;
+
+typedef struct iui_bundle_entry {
+    uint64_t name_offset; /* from file start, NUL-terminated */
+    uint64_t data_offset; /* from file start, IUI_BUNDLE_PAGE aligned */
+    uint64_t size;
+    uint64_t reserved;
+} iui_bundle_entry;
+
+/* Open handle over one mapped bundle file. */
+typedef struct iui_bundle iui_bundle;
+
+IUI_API iui_bundle *iui_bundle_open(const char *path);
+IUI_API void iui_bundle_close(iui_bundle *b);
+
+IUI_API uint32_t iui_bundle_entry_count(const iui_bundle *b);
+IUI_API const char *iui_bundle_entry_name(const iui_bundle *b, uint32_t index);
+
+/* Pointer directly into the mapping; valid until iui_bundle_close.  Returns
+ * NULL if the entry does not exist. */
+IUI_API const void *iui_bundle_find(const iui_bundle *b, const char *name,
+                                    uint64_t *size_out);
+
+/* Enumerate entries whose name starts with prefix: pass index 0,1,2...
+ * until NULL comes back.  Used by the warm-start loader to walk the
+ * "warm/" bytecode and trace-seed entries baked in at build time. */
+IUI_API const void *iui_bundle_find_prefix(const iui_bundle *b,
+                                           const char *prefix,
+                                           uint32_t index,
+                                           const char **name_out,
+                                           uint64_t *size_out);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* IUI_BUNDLE_H */
@@ -0,0 +1,53 @@
+/* capture.h — always-on interaction capture with bounded overhead.
+ *
+ * Production builds record every input event so any bug can be replayed,
+ * but JSON-logging 1000 Hz input on the frame loop is not acceptable.  A
+ * capture pushes fixed iui_event records into a preallocated SPSC ring —
+ * one memcpy and one release store, no locks, no allocation — and a
+ * background thread drains the ring into an IUIT trace file, the binary
+ * successor of the requests.jsonl schema (iui_trace_convert and the
+ * sharded replay reader both consume it).  If the flusher ever falls
+ * behind the ring drops records and counts them rather than stalling the
+ * frame loop.
+ *
+ * Attach a capture to a context and the input queue feeds it by itself:
+ * every pushed raw event is recorded and each iui_frame_begin writes the
+ * frame mark replay shards on.
+ */
+#ifndef IUI_CAPTURE_H
+#define IUI_CAPTURE_H
+
+#include "iui/trace.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct iui_capture iui_capture;
+
+/* Open the trace file, preallocate a ring of ring_records events (0 for
+ * the 16384 default) and start the flush thread. */
+IUI_API iui_capture *iui_capture_start(const char *path,
+                                       uint32_t ring_records);
+
+/* Drain what remains, finalize the trace header, join the flusher. */
+IUI_API iui_status iui_capture_stop(iui_capture *cap);
+
+/* Record one event (frame-loop side; wait-free).  The context integration
+ * below calls this for you. */
+IUI_API void iui_capture_record(iui_capture *cap, const iui_event *e);
+IUI_API void iui_capture_frame_mark(iui_capture *cap);
+
+/* Events lost to a full ring since start; should stay zero. */
+IUI_API uint64_t iui_capture_dropped(const iui_capture *cap);
+
+/* Feed this context's raw input stream and frame marks into cap; NULL
+ * detaches.  The capture must outlive the attachment. */
+IUI_API iui_status iui_context_set_capture(iui_context *ctx,
+                                           iui_capture *cap);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* IUI_CAPTURE_H */
@@ -0,0 +1,65 @@
+/* channel.h — lock-free single-producer/single-consumer update channel.
+ *
+ * Feed handlers push thousands of records per second at the UI; a
+ * mutex-guarded Lua table both contends and allocates.  A channel is a
+ * fixed-size ring of fixed-size records with one producer thread and one
+ * consumer thread: push and drain are a memcpy plus one release store
+ * each, no locks, no allocation after create.  The frame loop drains one
+ * bounded batch per frame.
+ *
+ * The control block and ring storage live in one allocation with the
+ * layout below frozen for FFI, so a LuaJIT thread can produce records
+ * with plain stores through iui_channel_shared (see lua/channel.lua).
+ * head and tail are free-running counters (slot = counter & (capacity-1))
+ * on separate cache lines; head is written only by the producer, tail
+ * only by the consumer.
+ */
+#ifndef IUI_CHANNEL_H
+#define IUI_CHANNEL_H
+
+#include "iui/iui.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Shared view of one channel; records follow the struct immediately,
+ * capacity * record_size bytes.  Layout is part of the ABI. */
+typedef struct iui_channel_shared {
+    uint32_t capacity;    /* power of two, fixed at create */
+    uint32_t record_size; /* bytes per record, fixed at create */
+    uint32_t reserved[14];
+    uint32_t head; /* producer cursor, own cache line */
+    uint32_t pad_head[15];
+    uint32_t tail; /* consumer cursor, own cache line */
+    uint32_t pad_tail[15];
+} iui_channel_shared;
+
+typedef struct iui_channel iui_channel;
+
+/* capacity is rounded up to a power of two.  NULL on bad args or OOM. */
+IUI_API iui_channel *iui_channel_create(uint32_t record_size,
+                                        uint32_t capacity);
+IUI_API void iui_channel_destroy(iui_channel *c);
+
+/* Producer side.  Copies record_size bytes in; returns IUI_ERR_BAD_STATE
+ * when the ring is full (the producer decides whether to drop or retry). */
+IUI_API iui_status iui_channel_push(iui_channel *c, const void *record);
+
+/* Consumer side.  Copies up to max_records out, returns the count.  Zero
+ * when the ring is empty. */
+IUI_API uint32_t iui_channel_drain(iui_channel *c, void *out,
+                                   uint32_t max_records);
+
+/* Records currently queued (approximate from either side). */
+IUI_API uint32_t iui_channel_pending(const iui_channel *c);
+
+/* The shared control block, for FFI producers/consumers that run the
+ * ring protocol themselves with plain stores. */
+IUI_API iui_channel_shared *iui_channel_view(iui_channel *c);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* IUI_CHANNEL_H */
@@ -0,0 +1,40 @@
+/* damage.h — frame-level damage tracking and partial redraw.
+ *
+ * The declaration API stays immediate-mode, but the core remembers each
+ * widget's subtree hash (bounds + declared content) from the previous
+ * frame.  At iui_frame_end, subtrees whose hash is unchanged are skipped
+ * and everything that appeared, moved, changed or vanished contributes its
+ * bounds to a small list of dirty rectangles.  A renderer that re-presents
+ * only those rectangles does no work on the 99%-static frames our
+ * dashboards spend most of their time in.
+ */
+#ifndef IUI_DAMAGE_H
+#define IUI_DAMAGE_H
+
+#include "iui/iui.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Hash of whatever the widget will draw (label text, colors, image id...).
+ * The core folds this into the subtree hash; equal hashes mean "no visual
+ * change".  Widgets that never set one are treated as static content. */
+IUI_API iui_status iui_widget_set_content_hash(iui_context *ctx,
+                                               uint64_t hash);
+
+/* Dirty rectangles for the frame just ended, valid until the next
+ * iui_frame_begin.  Writes at most max rects and returns the total number
+ * of damage rects (which may exceed max; pass max = 0 to just query). */
+IUI_API uint32_t iui_frame_damage(const iui_context *ctx, iui_rect *out,
+                                  uint32_t max);
+
+/* 1 if the widget's subtree changed this frame and must be re-rendered,
+ * 0 if its previous pixels are still valid. */
+IUI_API int iui_widget_is_dirty(const iui_context *ctx, iui_widget w);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* IUI_DAMAGE_H */
@@ -0,0 +1,56 @@
+/* geometry.h — bulk vertex/index emission for widget primitives.
+ *
+ * Instead of one FFI call per widget quad, the caller fills an array of
+ * draw descriptors and the kernel emits the whole frame's vertex and index
+ * buffers in one pass.  Plain rectangles go through a 4-wide SSE path
+ * (with a scalar fallback for hardware without SSE2, per the capability
+ * manifests shipped in the 2.2 bundles); rounded rectangles take a scalar
+ * corner-fan path.
+ */
+#ifndef IUI_GEOMETRY_H
+#define IUI_GEOMETRY_H
+
+#include "iui/iui.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Segments per rounded corner; fixed so output sizes are predictable. */
+#define IUI_CORNER_SEGMENTS 4
+
+typedef struct iui_draw_desc {
+    iui_rect rect;
+    float u0, v0, u1, v1;  /* texture coordinates of the rect corners */
+    uint32_t color;        /* RGBA8, premultiplied convention */
+    float corner_radius;   /* 0 = plain quad */
+    uint32_t texture;      /* texture handle, carried through for batching */
+} iui_draw_desc;
+
+/* 20 bytes; the leading x,y,u,v block is one aligned 16-byte store. */
+typedef struct iui_vertex {
+    float x, y;
+    float u, v;
+    uint32_t color;
+} iui_vertex;
+
+/* Exact output sizes for a descriptor batch, so callers can size buffers
+ * (or carve them from the frame arena) up front. */
+IUI_API void iui_geometry_measure(const iui_draw_desc *descs, uint32_t count,
+                                  uint32_t *vertex_count_out,
+                                  uint32_t *index_count_out);
+
+/* Emit vertices and 32-bit indices for the batch.  Indices are offset by
+ * base_vertex so batches can be appended to a shared buffer.  Buffers must
+ * hold at least the counts reported by iui_geometry_measure. */
+IUI_API iui_status iui_geometry_emit(const iui_draw_desc *descs,
+                                     uint32_t count, iui_vertex *vertices,
+                                     uint32_t *indices, uint32_t base_vertex,
+                                     uint32_t *vertex_count_out,
+                                     uint32_t *index_count_out);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* IUI_GEOMETRY_H */
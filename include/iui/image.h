@@ -0,0 +1,77 @@
+/* image.h — asynchronous image decode with visibility-priority scheduling.
+ *
+ * Decoding never runs on the frame thread: requests are queued with a
+ * priority (distance from the viewport works well — 0 for on-screen,
+ * growing for prefetch), dedicated workers decode in priority order, and
+ * results are published through per-job atomics so the frame thread polls
+ * without taking any lock.  Re-prioritizing an already queued image is
+ * cheap and takes effect at the next dequeue.
+ *
+ * The actual codec plugs in as a callback (the bundles carry their own
+ * decoders); a builtin handler for the raw "IRAW" format covers tests and
+ * benchmarks.
+ */
+#ifndef IUI_IMAGE_H
+#define IUI_IMAGE_H
+
+#include "iui/iui.h"
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct iui_image_pipeline iui_image_pipeline;
+typedef uint32_t iui_image;
+
+#define IUI_INVALID_IMAGE ((iui_image)0xffffffffu)
+
+typedef enum iui_image_state {
+    IUI_IMAGE_QUEUED = 0,
+    IUI_IMAGE_DECODING = 1,
+    IUI_IMAGE_READY = 2,
+    IUI_IMAGE_FAILED = 3,
+} iui_image_state;
+
+typedef struct iui_image_result {
+    uint32_t width, height;
+    const uint8_t *rgba; /* owned by the pipeline until the job is freed */
+} iui_image_result;
+
+/* Decode callback, called on a worker thread.  Must allocate *rgba_out
+ * with malloc (the pipeline frees it).  Return 0 on failure. */
+typedef int (*iui_image_decoder)(void *user, const void *data, size_t size,
+                                 uint8_t **rgba_out, uint32_t *width_out,
+                                 uint32_t *height_out);
+
+/* worker_count 0 picks a small default.  decoder NULL installs the builtin
+ * IRAW passthrough (uint32 magic 'IRAW', uint32 w, uint32 h, then RGBA). */
+IUI_API iui_image_pipeline *iui_image_pipeline_create(
+    uint32_t worker_count, iui_image_decoder decoder, void *user);
+IUI_API void iui_image_pipeline_destroy(iui_image_pipeline *p);
+
+/* Queue a decode.  data must stay valid until the job leaves QUEUED/
+ * DECODING (mapped bundle entries qualify).  Lower priority decodes
+ * sooner. */
+IUI_API iui_image iui_image_request(iui_image_pipeline *p, const void *data,
+                                    size_t size, float priority);
+
+/* Update scheduling priority, e.g. as thumbnails scroll toward the
+ * viewport.  No-op once decoding started. */
+IUI_API void iui_image_set_priority(iui_image_pipeline *p, iui_image img,
+                                    float priority);
+
+/* Lock-free poll from the frame thread; fills *out when READY. */
+IUI_API iui_image_state iui_image_poll(const iui_image_pipeline *p,
+                                       iui_image img,
+                                       iui_image_result *out);
+
+/* Release a job's pixels once uploaded (or a stale request). */
+IUI_API void iui_image_free(iui_image_pipeline *p, iui_image img);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* IUI_IMAGE_H */
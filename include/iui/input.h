@@ -0,0 +1,54 @@
+/* input.h — frame-synchronized input queue with event coalescing.
+ *
+ * High-rate pointing devices deliver events at 1000 Hz; handing every one
+ * to the UI individually blows the frame budget during fast scrolls.  The
+ * queue timestamps events as they arrive, folds runs of compatible events
+ * (mouse/touch moves and scroll ticks from the same device) into single
+ * records by accumulating their deltas, and publishes a bounded batch at
+ * the next iui_frame_begin.  The raw, uncoalesced stream is kept in a
+ * fixed ring so gesture recognizers can still see individual samples.
+ *
+ * Events reuse iui_event from trace.h, so a captured trace can be pushed
+ * straight back through this queue during replay.
+ */
+#ifndef IUI_INPUT_H
+#define IUI_INPUT_H
+
+#include "iui/trace.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Upper bound on events handed to the UI per frame.  When the pending
+ * batch is full, further move/scroll events keep folding into the record
+ * they match; anything else overflows and is counted as dropped. */
+#define IUI_INPUT_BATCH_MAX 64u
+
+/* Samples retained in the raw history ring. */
+#define IUI_INPUT_HISTORY_SIZE 1024u
+
+/* Queue one event.  Safe to call at device-interrupt rate between frames;
+ * never allocates.  A zero time_us is replaced with the current clock. */
+IUI_API void iui_input_push(iui_context *ctx, const iui_event *e);
+
+/* The coalesced batch for the frame opened by the last iui_frame_begin,
+ * in arrival order.  Valid until the next iui_frame_begin. */
+IUI_API const iui_event *iui_input_events(const iui_context *ctx,
+                                          uint32_t *count_out);
+
+/* Events that overflowed the batch since the last frame (should be zero;
+ * nonzero means the app is not pumping frames). */
+IUI_API uint32_t iui_input_dropped(const iui_context *ctx);
+
+/* Raw uncoalesced samples, newest first: age 0 is the most recent push.
+ * Returns NULL once age exceeds the retained history. */
+IUI_API const iui_event *iui_input_history(const iui_context *ctx,
+                                           uint32_t age);
+IUI_API uint32_t iui_input_history_count(const iui_context *ctx);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* IUI_INPUT_H */
@@ -0,0 +1,54 @@
+/* intern.h — stable 32-bit handles for widget IDs and labels.
+ *
+ * Immediate-mode call sites pass ID strings every frame, and every one
+ * is hashed and compared again — about 6% of the profile in the bundles,
+ * plus steady small allocations on the Lua side.  The intern table
+ * resolves a string once to a stable handle; afterwards call sites pass
+ * the integer and the core uses the stored hash and bytes directly:
+ * iui_widget_begin_h skips the per-call FNV walk, iui_text_shape_h feeds
+ * the shaped-run cache by handle.
+ *
+ * The table is process-wide (shared by all windows, like the worker
+ * pool), append-only, and occupancy-aware: the open-addressed index
+ * rehashes when it passes 70% load, so lookups stay at one or two probes
+ * no matter how many labels an app accumulates.  Handles are never
+ * reused or freed.
+ */
+#ifndef IUI_INTERN_H
+#define IUI_INTERN_H
+
+#include "iui/text.h"
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef uint32_t iui_str;
+
+#define IUI_INVALID_STR ((iui_str)0)
+
+/* Intern a string (len 0 = strlen).  Returns the existing handle for a
+ * string seen before; IUI_INVALID_STR only on OOM. */
+IUI_API iui_str iui_intern(const char *s, size_t len);
+
+/* The interned bytes; stable for the process lifetime.  NULL for an
+ * invalid handle. */
+IUI_API const char *iui_str_text(iui_str s, size_t *len_out);
+IUI_API uint64_t iui_str_hash(iui_str s);
+IUI_API uint32_t iui_intern_count(void);
+
+/* iui_widget_begin with a pre-resolved ID: no hashing on the call. */
+IUI_API iui_widget iui_widget_begin_h(iui_context *ctx, iui_str id);
+
+/* iui_text_shape by handle; hits the same run cache as the string form
+ * (the intern table stores the identical hash). */
+IUI_API const iui_shaped_run *iui_text_shape_h(iui_text_system *ts,
+                                               iui_font font, iui_str s);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* IUI_INTERN_H */
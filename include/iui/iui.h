@@ -0,0 +1,92 @@
+/* iui.h — public C API for the libiui native core.
+ *
+ * Everything here is FFI-safe: plain C types, no callbacks into the widget
+ * walk, stable struct layouts.  The LuaJIT side (see lua/iui_core.lua) loads
+ * this through ffi.cdef and drives the frame loop; the per-frame widget
+ * traversal, layout and hit-testing all run natively.
+ */
+#ifndef IUI_H
+#define IUI_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef _WIN32
+#define IUI_API __declspec(dllexport)
+#else
+#define IUI_API __attribute__((visibility("default")))
+#endif
+
+/* Opaque per-instance state: widget tree, layout results, caches. */
+typedef struct iui_context iui_context;
+
+/* Stable widget handle.  0 is the invalid handle; 1 is the frame root. */
+typedef uint32_t iui_widget;
+
+#define IUI_INVALID_WIDGET ((iui_widget)0)
+
+typedef enum iui_status {
+    IUI_OK = 0,
+    IUI_ERR_INVALID_ARG = 1,
+    IUI_ERR_OUT_OF_MEMORY = 2,
+    IUI_ERR_BAD_STATE = 3,
+    IUI_ERR_IO = 4,
+    IUI_ERR_CORRUPT = 5,
+} iui_status;
+
+typedef struct iui_rect {
+    float x, y, w, h;
+} iui_rect;
+
+/* Layout behaviour of a widget's children. */
+typedef enum iui_axis {
+    IUI_AXIS_COLUMN = 0, /* children stacked top to bottom */
+    IUI_AXIS_ROW = 1,    /* children stacked left to right */
+} iui_axis;
+
+/* Per-widget sizing: non-negative values are fixed pixels, IUI_SIZE_FILL
+ * shares the remaining space on the parent axis equally among fill children,
+ * IUI_SIZE_FIT wraps the children. */
+#define IUI_SIZE_FILL (-1.0f)
+#define IUI_SIZE_FIT (-2.0f)
+
+IUI_API iui_context *iui_context_create(void);
+IUI_API void iui_context_destroy(iui_context *ctx);
+
+/* Worker threads for parallel phases (layout islands, trace decode).
+ * 0 = size from the hardware.  Only honoured before the shared pool is
+ * first used; call it at startup. */
+IUI_API void iui_set_worker_threads(uint32_t count);
+
+/* A frame is: begin, declare the widget tree, end.  iui_frame_end runs the
+ * layout pass so bounds/hit-testing are valid until the next begin. */
+IUI_API iui_status iui_frame_begin(iui_context *ctx, float width, float height);
+IUI_API iui_status iui_frame_end(iui_context *ctx);
+
+/* Declare a widget as a child of the current parent and make it the parent
+ * for subsequent declarations until the matching iui_widget_end.  The id
+ * only needs to be unique among siblings. */
+IUI_API iui_widget iui_widget_begin(iui_context *ctx, const char *id);
+IUI_API iui_status iui_widget_end(iui_context *ctx);
+
+IUI_API iui_status iui_widget_set_size(iui_context *ctx, float w, float h);
+IUI_API iui_status iui_widget_set_axis(iui_context *ctx, iui_axis axis);
+IUI_API iui_status iui_widget_set_padding(iui_context *ctx, float padding);
+IUI_API iui_status iui_widget_set_spacing(iui_context *ctx, float spacing);
+
+/* Valid after iui_frame_end, in window coordinates. */
+IUI_API iui_status iui_widget_bounds(const iui_context *ctx, iui_widget w,
+                                     iui_rect *out);
+IUI_API uint32_t iui_widget_count(const iui_context *ctx);
+
+/* Topmost widget containing the point, or IUI_INVALID_WIDGET. */
+IUI_API iui_widget iui_hit_test(const iui_context *ctx, float x, float y);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* IUI_H */
@@ -0,0 +1,71 @@
+/* layer.h — persistent scroll layers: render once, blit thereafter.
+ *
+ * Scrolling a big pane used to re-render every visible line each frame.
+ * A scroll layer keeps the pane's content in a persistent texture the
+ * renderer owns, addressed as a ring along the scroll axis: content row y
+ * lives at texture row y mod layer_height.  Scrolling then costs one
+ * wrap-aware blit, and only the strip of content that scrolled into view
+ * (or was invalidated by the damage engine) is re-rendered.
+ *
+ * The core does the bookkeeping only — it hands back the content-space
+ * strips to (re)render and maps content rows to texture rows; recording
+ * the strip draws and the final blit stays in the renderer, like every
+ * other consumer of iui_cmd_buffer.
+ *
+ * Per frame:
+ *   n = iui_scroll_layer_update(layer, scroll_y, strips);
+ *   for each strip: render it into the texture at
+ *       iui_scroll_layer_texture_y(layer, strip.y)
+ *   blit the view from texture rows texture_y(scroll_y).. with wrap
+ *
+ * Layers persist across frames keyed by widget path; they are reclaimed
+ * with the context.
+ */
+#ifndef IUI_LAYER_H
+#define IUI_LAYER_H
+
+#include "iui/iui.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* An update can split the exposed range and the dirty range at the ring
+ * wrap, so four strips bound the worst case. */
+#define IUI_LAYER_MAX_STRIPS 4u
+
+typedef struct iui_scroll_layer iui_scroll_layer;
+
+/* Layer for the given widget, created on first use.  view_h is the
+ * visible height; layer_h the texture height, at least view_h — slack
+ * above view_h turns small scroll reversals into pure blits.  A size
+ * change resets the layer (full re-render on the next update). */
+IUI_API iui_scroll_layer *iui_scroll_layer_get(iui_context *ctx,
+                                               iui_widget w, float view_w,
+                                               float view_h, float layer_h);
+
+/* Renderer's texture handle for this layer; opaque to the core. */
+IUI_API void iui_scroll_layer_set_texture(iui_scroll_layer *l, uint32_t tex);
+IUI_API uint32_t iui_scroll_layer_texture(const iui_scroll_layer *l);
+
+/* Advance to this frame's scroll offset.  Fills strips_out (content-space
+ * rects, already split at the ring wrap) with what must be re-rendered
+ * into the texture and returns the strip count — 0 when the frame is a
+ * pure blit. */
+IUI_API uint32_t iui_scroll_layer_update(iui_scroll_layer *l, float scroll_y,
+                                         iui_rect strips_out[4]);
+
+/* Texture row holding content row y.  Valid for content currently resident
+ * in the ring. */
+IUI_API float iui_scroll_layer_texture_y(const iui_scroll_layer *l, float y);
+
+/* Mark a content-space range dirty (feed damage rects that overlap the
+ * pane through this); it is folded into the next update's strips. */
+IUI_API void iui_scroll_layer_invalidate(iui_scroll_layer *l, float y0,
+                                         float y1);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* IUI_LAYER_H */
@@ -0,0 +1,48 @@
+/* list.h — virtualized list/table container.
+ *
+ * Million-row tables cannot declare a widget per row per frame.  A
+ * virtual list materializes only the rows intersecting the viewport plus
+ * a prefetch margin: iui_list_begin computes that window from the pane's
+ * scroll offset and returns it, the caller declares exactly those rows,
+ * and spacer widgets stand in for everything above and below so layout,
+ * scrollbars and FIT sizing see the full virtual extent.
+ *
+ * Rows are fixed-height, which is what makes the window computation O(1).
+ * Scrolling goes through the pane's store slot (iui_slot_set_scroll with
+ * the slot returned in iui_list_info); the clamp range comes back in
+ * max_scroll.
+ */
+#ifndef IUI_LIST_H
+#define IUI_LIST_H
+
+#include "iui/store.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct iui_list_info {
+    uint64_t first_row; /* first row the caller must declare */
+    uint32_t row_count; /* number of rows to declare */
+    iui_slot slot;      /* pane slot, for iui_slot_set_scroll */
+    float max_scroll;   /* clamp for the scroll offset */
+} iui_list_info;
+
+/* Begins the pane widget (size it like any widget before declaring rows).
+ * The window is computed from the pane's height as of the previous frame —
+ * the usual immediate-mode one-frame latency on first appearance. */
+IUI_API iui_status iui_list_begin(iui_context *ctx, const char *id,
+                                  uint64_t total_rows, float row_height,
+                                  uint32_t margin_rows, iui_list_info *out);
+
+/* Declare one row from the returned window, in order. */
+IUI_API iui_status iui_list_row_begin(iui_context *ctx, uint64_t row);
+IUI_API iui_status iui_list_row_end(iui_context *ctx);
+
+IUI_API iui_status iui_list_end(iui_context *ctx);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* IUI_LIST_H */
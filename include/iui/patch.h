@@ -0,0 +1,63 @@
+/* patch.h — differential bundle updates.
+ *
+ * A patch ("IUIP") is built by content-defined chunking: both files are
+ * cut at rolling-hash boundaries (so an insertion early in the bundle
+ * shifts chunk contents, not every boundary after it), chunks already
+ * present in the installed file become copy records, and only genuinely
+ * new bytes ship inline.  The launcher's updater applies a patch against
+ * the installed bundle and verifies the result hash before swapping it in,
+ * so a failed or torn download can never produce a half-patched install.
+ *
+ * Patch creation lives in the iui_bundle_diff tool (it runs on the release
+ * server); applying lives here so the launcher links only the core.
+ */
+#ifndef IUI_PATCH_H
+#define IUI_PATCH_H
+
+#include "iui/iui.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define IUI_PATCH_MAGIC 0x50495549u /* "IUIP" */
+#define IUI_PATCH_VERSION 1u
+
+typedef enum iui_patch_op {
+    IUI_PATCH_COPY = 0,   /* take bytes from the installed file */
+    IUI_PATCH_INSERT = 1, /* literal bytes follow the record */
+} iui_patch_op;
+
+typedef struct iui_patch_header {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t record_count;
+    uint64_t new_size;
+    uint64_t new_hash; /* FNV-1a of the patched result, verified on apply */
+} iui_patch_header;
+
+typedef struct iui_patch_record {
+    uint32_t op;
+    uint32_t reserved;
+    uint64_t offset; /* COPY: offset in the installed file */
+    uint64_t length;
+} iui_patch_record;
+
+/* Content-defined chunking parameters, shared by diff and any tooling
+ * that wants stable boundaries. */
+#define IUI_CDC_MIN_CHUNK 2048u
+#define IUI_CDC_AVG_MASK 0x1fffu /* boundary when (gear & mask) == 0, ~8 KiB */
+#define IUI_CDC_MAX_CHUNK 65536u
+
+/* Apply patch_path against old_path, writing out_path.  Verifies the
+ * result against the hash stored in the patch; on any failure out_path is
+ * removed and the installed file is untouched. */
+IUI_API iui_status iui_patch_apply(const char *old_path,
+                                   const char *patch_path,
+                                   const char *out_path);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* IUI_PATCH_H */
@@ -0,0 +1,64 @@
+/* profiler.h — always-on frame instrumentation.
+ *
+ * Kiosks in the field expose no timing at all, so the core keeps its own:
+ * per-phase wall time, a small set of app-defined counters (widgets per
+ * type, draw calls, cache hits...), and a ring of the last 256 frames that
+ * can be copied out or dumped to a requests.jsonl-style file for offline
+ * triage.  Overhead is two clock reads per phase and a few stores per
+ * frame — cheap enough to leave enabled in production.
+ *
+ * The layout phase is timed by the core itself inside iui_frame_end; the
+ * other phases are bracketed by the embedder around its own work.
+ */
+#ifndef IUI_PROFILER_H
+#define IUI_PROFILER_H
+
+#include "iui/iui.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum iui_phase {
+    IUI_PHASE_INPUT = 0,
+    IUI_PHASE_BUILD = 1,  /* widget declaration (script side) */
+    IUI_PHASE_LAYOUT = 2, /* timed internally */
+    IUI_PHASE_TEXT = 3,
+    IUI_PHASE_GEOMETRY = 4,
+    IUI_PHASE_PRESENT = 5,
+    IUI_PHASE_COUNT = 6,
+} iui_phase;
+
+#define IUI_PROFILE_COUNTERS 16
+
+typedef struct iui_frame_profile {
+    uint64_t frame_index;
+    uint64_t start_us;  /* since context creation */
+    uint32_t total_us;  /* frame_begin to frame_begin */
+    uint32_t phase_us[IUI_PHASE_COUNT];
+    uint32_t counters[IUI_PROFILE_COUNTERS];
+} iui_frame_profile;
+
+IUI_API void iui_profile_phase_begin(iui_context *ctx, iui_phase phase);
+IUI_API void iui_profile_phase_end(iui_context *ctx, iui_phase phase);
+
+/* Accumulates into the current frame's counter slot; slots are reset each
+ * frame.  Slot meaning is up to the embedder and carried verbatim into
+ * history and dumps. */
+IUI_API void iui_profile_counter_add(iui_context *ctx, uint32_t slot,
+                                     uint32_t amount);
+
+/* Copy out up to max completed frame records, oldest first.  Returns the
+ * number written. */
+IUI_API uint32_t iui_profile_history(const iui_context *ctx,
+                                     iui_frame_profile *out, uint32_t max);
+
+/* Append the ring to a jsonl file, one {"type":"profile",...} object per
+ * frame — the same shape the replay tooling already ingests. */
+IUI_API iui_status iui_profile_dump(const iui_context *ctx, const char *path);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* IUI_PROFILER_H */
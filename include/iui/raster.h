@@ -0,0 +1,61 @@
+/* raster.h — headless software rasterizer for server-side snapshots.
+ *
+ * Consumes the same batches, vertices and indices the GPU backend gets
+ * from iui_cmd_buffer and rasterizes them into an RGBA8 framebuffer: no
+ * window, no driver, no hidden-surface screenshot.  Triangles go through
+ * a scanline walk with SIMD span fills, so a 1080p dashboard frame is a
+ * few milliseconds on one server core.
+ *
+ * Textures the command stream references (the glyph atlas, image
+ * pipeline results) are registered up front; texture 0 is the solid
+ * fill.  Output is either an uncompressed-deflate PNG — self-contained,
+ * every viewer reads it, no zlib dependency — or the raw framebuffer for
+ * pipelines that encode themselves.
+ */
+#ifndef IUI_RASTER_H
+#define IUI_RASTER_H
+
+#include "iui/render.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum iui_raster_format {
+    IUI_RASTER_A8 = 0,    /* coverage, modulates the vertex color */
+    IUI_RASTER_RGBA8 = 1, /* premultiplied, modulated by the vertex color */
+} iui_raster_format;
+
+typedef struct iui_raster iui_raster;
+
+IUI_API iui_raster *iui_raster_create(uint32_t width, uint32_t height);
+IUI_API void iui_raster_destroy(iui_raster *r);
+
+/* Fill the framebuffer with one premultiplied RGBA8 color. */
+IUI_API void iui_raster_clear(iui_raster *r, uint32_t color);
+
+/* Register pixels for a texture handle; data is copied.  Re-registering
+ * an id replaces it. */
+IUI_API iui_status iui_raster_set_texture(iui_raster *r, uint32_t id,
+                                          const void *pixels, uint32_t width,
+                                          uint32_t height,
+                                          iui_raster_format format);
+
+/* Rasterize a finished command buffer into the framebuffer. */
+IUI_API iui_status iui_raster_execute(iui_raster *r,
+                                      const iui_cmd_buffer *cb);
+
+/* Framebuffer rows, top-down, width * height premultiplied RGBA8. */
+IUI_API const uint8_t *iui_raster_pixels(const iui_raster *r,
+                                         uint32_t *width, uint32_t *height);
+
+IUI_API iui_status iui_raster_write_png(const iui_raster *r,
+                                        const char *path);
+IUI_API iui_status iui_raster_write_raw(const iui_raster *r,
+                                        const char *path);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* IUI_RASTER_H */
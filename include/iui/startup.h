@@ -0,0 +1,47 @@
+/* startup.h — cold-start phase markers and the budget trace.
+ *
+ * The launchers give no visibility into where startup time goes:
+ * extraction, runtime load, JIT warmup, atlas build, first layout.  The
+ * startup trace is a small preallocated table of timestamped phase
+ * markers — the core drops marks at its own milestones (bundle open,
+ * context and text-system creation, cache loads, the first completed
+ * frame) and the launcher adds its own through the FFI.  At the end of
+ * startup the trace is written as one jsonl line per phase, and
+ * iui_startup_report prints the waterfall with deltas against a stored
+ * baseline, so every startup optimization is verifiable in the field.
+ *
+ * Marking is two reads of the clock away from free and safe before any
+ * context exists; the table is process-wide and fixed-size, so tracing
+ * can stay enabled in production builds.
+ */
+#ifndef IUI_STARTUP_H
+#define IUI_STARTUP_H
+
+#include "iui/iui.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define IUI_STARTUP_MAX_MARKS 64u
+
+/* Anchor t=0.  Call first thing in the launcher; if never called, the
+ * first mark anchors the clock instead. */
+IUI_API void iui_startup_begin(void);
+
+/* Record one phase boundary: the phase is credited the time since the
+ * previous mark (or since begin).  Names longer than 31 bytes are
+ * truncated; marks past the table size are dropped. */
+IUI_API void iui_startup_mark(const char *phase);
+
+/* Write the trace: one {"phase":...,"t_us":...,"dt_us":...} line per
+ * mark, requests.jsonl-style. */
+IUI_API iui_status iui_startup_write(const char *path);
+
+IUI_API uint32_t iui_startup_count(void);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* IUI_STARTUP_H */
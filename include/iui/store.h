@@ -0,0 +1,53 @@
+/* store.h — the persistent structure-of-arrays widget store.
+ *
+ * State that must survive across immediate-mode frames (bounds, scroll
+ * offsets, animation values) lives in parallel typed columns indexed by a
+ * stable slot.  A widget keeps its slot as long as it is declared at the
+ * same path, no matter how the frame's declaration order shifts, so
+ * cross-frame systems (animation, spatial index, renderers) address
+ * widgets by integer and iterate hot columns linearly instead of chasing
+ * per-widget heap objects.
+ *
+ * Slots of widgets not declared for a while are recycled; holders of a
+ * slot should re-resolve it if they stop declaring the widget.
+ */
+#ifndef IUI_STORE_H
+#define IUI_STORE_H
+
+#include "iui/iui.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef uint32_t iui_slot;
+
+#define IUI_INVALID_SLOT ((iui_slot)0xffffffffu)
+
+/* Slot of the widget currently being declared (between widget_begin and
+ * widget_end).  Stable across frames for the same widget path. */
+IUI_API iui_slot iui_widget_slot(const iui_context *ctx);
+
+/* Slot lookup for a widget handle of the current frame. */
+IUI_API iui_slot iui_slot_of(const iui_context *ctx, iui_widget w);
+
+/* Number of live slots (upper bound for iterating the columns). */
+IUI_API uint32_t iui_store_size(const iui_context *ctx);
+
+/* Column accessors.  Pointers stay valid until the store grows (at most
+ * once per frame), which makes them safe to hold for one frame — the same
+ * contract as frame-arena memory. */
+IUI_API const iui_rect *iui_store_bounds(const iui_context *ctx);
+
+/* Scroll offset applied to the widget's children during layout.  Set from
+ * input handling, persists until changed. */
+IUI_API iui_status iui_slot_set_scroll(iui_context *ctx, iui_slot slot,
+                                       float x, float y);
+IUI_API iui_status iui_slot_get_scroll(const iui_context *ctx, iui_slot slot,
+                                       float *x, float *y);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* IUI_STORE_H */
@@ -0,0 +1,104 @@
+/* text.h — persistent glyph atlas and shaped-run cache.
+ *
+ * Shaping and rasterizing text every immediate-mode frame is the dominant
+ * cost on text-heavy views, so both are cached across frames.  Glyphs are
+ * packed once into a shared alpha atlas; shaped runs are cached by
+ * (string hash, font) and a hit costs one hash lookup and returns quads
+ * that index straight into the atlas.  All returned structs are POD so the
+ * LuaJIT side and the native renderer read the same cache through the FFI.
+ *
+ * Fonts plug in through callbacks (advance metrics and glyph
+ * rasterization); when none are given a builtin monospace block font is
+ * used, which keeps headless and bench runs font-free.
+ */
+#ifndef IUI_TEXT_H
+#define IUI_TEXT_H
+
+#include "iui/iui.h"
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct iui_text_system iui_text_system;
+typedef uint32_t iui_font;
+
+#define IUI_INVALID_FONT ((iui_font)0)
+
+typedef struct iui_glyph_metrics {
+    float advance;             /* pen advance, pixels */
+    float bearing_x, bearing_y; /* bitmap origin relative to pen/baseline */
+    uint32_t width, height;    /* bitmap size, pixels; 0 for whitespace */
+} iui_glyph_metrics;
+
+typedef struct iui_font_desc {
+    float size_px;       /* nominal size; also the line height basis */
+    void *user;          /* passed to both callbacks */
+    /* Fill metrics for a codepoint.  Return 0 for "no such glyph". */
+    int (*metrics)(void *user, uint32_t codepoint, iui_glyph_metrics *out);
+    /* Write width*height alpha bytes (row-major, stride = width). */
+    void (*rasterize)(void *user, uint32_t codepoint, uint8_t *out,
+                      uint32_t width, uint32_t height);
+} iui_font_desc;
+
+/* One positioned glyph: screen-space quad (relative to the run origin at
+ * the baseline) and its atlas UVs. */
+typedef struct iui_glyph_quad {
+    float x0, y0, x1, y1;
+    float u0, v0, u1, v1;
+} iui_glyph_quad;
+
+typedef struct iui_shaped_run {
+    const iui_glyph_quad *quads; /* valid until the run is evicted */
+    uint32_t glyph_count;
+    float width;
+    float height;
+} iui_shaped_run;
+
+IUI_API iui_text_system *iui_text_create(uint32_t atlas_width,
+                                         uint32_t atlas_height);
+IUI_API void iui_text_destroy(iui_text_system *ts);
+
+/* desc may be NULL to get the builtin monospace font at 13 px. */
+IUI_API iui_font iui_text_register_font(iui_text_system *ts,
+                                        const iui_font_desc *desc);
+
+/* Shape (or fetch from cache) one UTF-8 run.  The returned pointer stays
+ * valid across frames until eviction; re-shaping an unchanged string is a
+ * single hash lookup.  len may be 0 to use strlen. */
+IUI_API const iui_shaped_run *iui_text_shape(iui_text_system *ts,
+                                             iui_font font, const char *text,
+                                             size_t len);
+
+/* The A8 atlas bitmap for texture upload.  version increments whenever new
+ * glyphs were packed, so renderers re-upload only on change. */
+IUI_API const uint8_t *iui_text_atlas(const iui_text_system *ts,
+                                      uint32_t *width, uint32_t *height);
+IUI_API uint32_t iui_text_atlas_version(const iui_text_system *ts);
+
+/* Advance the eviction clock; call once per frame.  Runs untouched for a
+ * few hundred frames are dropped once the cache grows past its budget. */
+IUI_API void iui_text_frame(iui_text_system *ts);
+
+/* Persistent cache ("IUIC"): the packed atlas, glyph table and shaped
+ * runs survive across launches, so a warm start skips shaping and
+ * rasterizing every piece of static UI text.
+ *
+ * key guards validity — hash the installed bundle version and the font
+ * set into it (iui_text_cache_load fails with IUI_ERR_BAD_STATE on a
+ * mismatch, IUI_ERR_CORRUPT on a damaged file, and the system is left
+ * empty but usable).  Load into a freshly created system with the same
+ * atlas dimensions and the same fonts registered in the same order;
+ * save at shutdown, typically next to the bundle. */
+IUI_API iui_status iui_text_cache_save(const iui_text_system *ts,
+                                       const char *path, uint64_t key);
+IUI_API iui_status iui_text_cache_load(iui_text_system *ts,
+                                       const char *path, uint64_t key);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* IUI_TEXT_H */
@@ -0,0 +1,75 @@
+/* theme.h — widget styles as flat constant tables.
+ *
+ * The 3.2 bundle resolved styles through chained Lua table lookups per
+ * widget per frame (~12% of the frame profile).  Here a theme is one POD
+ * array indexed [kind][state]: resolution is two shifts and an add, no
+ * hashing, no chasing.  The default theme is built at compile time in
+ * theme.cpp and lives in the library's read-only data, so the FFI layer
+ * can hold one pointer and index it directly from Lua without crossing
+ * back into C.
+ *
+ * Colors are 0xAABBGGRR to match iui_vertex.
+ */
+#ifndef IUI_THEME_H
+#define IUI_THEME_H
+
+#include "iui/iui.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum iui_widget_kind {
+    IUI_KIND_PANEL = 0,
+    IUI_KIND_BUTTON = 1,
+    IUI_KIND_LABEL = 2,
+    IUI_KIND_INPUT = 3,
+    IUI_KIND_LIST_ROW = 4,
+    IUI_KIND_SCROLLBAR = 5,
+    IUI_KIND_COUNT = 6,
+} iui_widget_kind;
+
+typedef enum iui_widget_state {
+    IUI_STATE_NORMAL = 0,
+    IUI_STATE_HOVER = 1,
+    IUI_STATE_ACTIVE = 2,
+    IUI_STATE_DISABLED = 3,
+    IUI_STATE_COUNT = 4,
+} iui_widget_state;
+
+/* Everything style resolution can yield for one (kind, state) pair. */
+typedef struct iui_style {
+    uint32_t bg_color;
+    uint32_t fg_color;
+    uint32_t border_color;
+    float border_width;
+    float corner_radius;
+    float padding;
+    float spacing;
+    uint32_t font; /* index into the app's font set */
+} iui_style;
+
+typedef struct iui_theme {
+    iui_style styles[IUI_KIND_COUNT][IUI_STATE_COUNT];
+} iui_theme;
+
+/* The precompiled default theme; static storage, never freed. */
+IUI_API const iui_theme *iui_theme_default(void);
+
+/* Theme used by the context; defaults to iui_theme_default().  The
+ * pointer is retained, not copied — it must outlive the context. */
+IUI_API void iui_context_set_theme(iui_context *ctx, const iui_theme *t);
+IUI_API const iui_theme *iui_context_theme(const iui_context *ctx);
+
+/* Convenience resolver for C callers; FFI code should index the table
+ * directly.  Never returns NULL: out-of-range indices clamp to
+ * (PANEL, NORMAL). */
+IUI_API const iui_style *iui_style_resolve(const iui_context *ctx,
+                                           iui_widget_kind kind,
+                                           iui_widget_state state);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* IUI_THEME_H */
@@ -0,0 +1,104 @@
+/* trace.h — binary event traces: the replay-speed successor to
+ * requests.jsonl.
+ *
+ * A trace file ("IUIT") is a header followed by length-prefixed records.
+ * Every record starts with a fixed iui_event; the length prefix lets future
+ * versions append payload bytes without breaking old readers.  The reader
+ * maps the file and yields pointers straight into the mapping — replay
+ * never parses text or copies records.
+ *
+ * iui_trace_convert turns a requests.jsonl capture into this format.
+ */
+#ifndef IUI_TRACE_H
+#define IUI_TRACE_H
+
+#include "iui/iui.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define IUI_TRACE_MAGIC 0x54495549u /* "IUIT" */
+#define IUI_TRACE_VERSION 1u
+
+typedef enum iui_event_type {
+    IUI_EVENT_NONE = 0,
+    IUI_EVENT_MOUSE_MOVE = 1,
+    IUI_EVENT_MOUSE_DOWN = 2,
+    IUI_EVENT_MOUSE_UP = 3,
+    IUI_EVENT_SCROLL = 4,
+    IUI_EVENT_KEY_DOWN = 5,
+    IUI_EVENT_KEY_UP = 6,
+    IUI_EVENT_TEXT = 7,
+    IUI_EVENT_TOUCH_DOWN = 8,
+    IUI_EVENT_TOUCH_MOVE = 9,
+    IUI_EVENT_TOUCH_UP = 10,
+    /* Frame boundary marker; frame-synchronized consumers and the sharded
+     * replay reader split the stream here. */
+    IUI_EVENT_FRAME_MARK = 15,
+} iui_event_type;
+
+typedef struct iui_event {
+    uint32_t type;    /* iui_event_type */
+    uint32_t device;  /* source device index */
+    uint64_t time_us; /* capture timestamp, microseconds */
+    float x, y;       /* position, window coordinates */
+    float dx, dy;     /* movement / scroll delta */
+    uint32_t code;    /* key code, button index or codepoint */
+    uint32_t frame;   /* frame index at capture time */
+} iui_event;
+
+typedef struct iui_trace_header {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t record_count;
+} iui_trace_header;
+
+/* Each record on disk: uint32_t size (bytes after the prefix, at least
+ * sizeof(iui_event)), then the event, then optional payload. */
+
+typedef struct iui_trace_reader iui_trace_reader;
+
+IUI_API iui_trace_reader *iui_trace_open(const char *path);
+IUI_API void iui_trace_close(iui_trace_reader *r);
+IUI_API uint64_t iui_trace_count(const iui_trace_reader *r);
+
+/* Next event, zero-copy out of the mapping; NULL at end of trace. */
+IUI_API const iui_event *iui_trace_next(iui_trace_reader *r);
+IUI_API void iui_trace_rewind(iui_trace_reader *r);
+
+/* Parallel frame-sharded ingestion.
+ *
+ * The trace is split at IUI_EVENT_FRAME_MARK boundaries and the shards are
+ * decoded on the worker pool into per-frame batches; consumption stays in
+ * frame order, so replay sees exactly the sequential stream.  Build once,
+ * then feed frame after frame to the loop (or to iui_input_push).
+ *
+ * Batches point into the reader's mapping: keep the reader open until the
+ * frames handle is destroyed. */
+typedef struct iui_trace_frames iui_trace_frames;
+
+IUI_API iui_trace_frames *iui_trace_frames_build(iui_trace_reader *r);
+IUI_API void iui_trace_frames_destroy(iui_trace_frames *f);
+
+IUI_API uint64_t iui_trace_frames_count(const iui_trace_frames *f);
+
+/* Events of one frame in capture order, excluding the closing frame mark.
+ * NULL when the frame index is out of range. */
+IUI_API const iui_event *const *
+iui_trace_frames_events(const iui_trace_frames *f, uint64_t frame,
+                        uint32_t *count_out);
+
+/* Streaming writer used by the converter and by capture mode. */
+typedef struct iui_trace_writer iui_trace_writer;
+
+IUI_API iui_trace_writer *iui_trace_writer_open(const char *path);
+IUI_API iui_status iui_trace_write(iui_trace_writer *w, const iui_event *e);
+/* Rewrites the header with the final record count and closes the file. */
+IUI_API iui_status iui_trace_writer_close(iui_trace_writer *w);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* IUI_TRACE_H */
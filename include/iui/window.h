@@ -0,0 +1,74 @@
+/* window.h — multiple windows in one process, one present thread each.
+ *
+ * A control room driving six displays used to run six processes, each
+ * with its own copy of the runtime, atlases and caches.  A window set
+ * holds one iui_context per window inside a single process, so the
+ * expensive state — glyph atlas and run cache (iui_text_system), decoded
+ * images (iui_image_pipeline), the worker pool, loaded bundles — is
+ * created once and shared by every window, while per-window declaration
+ * state stays isolated.
+ *
+ * Presentation runs on a dedicated thread per window: the main loop
+ * declares all windows' frames, then kicks the set.  Each present thread
+ * wakes, runs the window's present callback against its swapchain, and
+ * goes back to sleep.  Kicks do not wait — a display holding vsync at
+ * 30 Hz drops to presenting every other frame without stalling its
+ * neighbours or the declaration loop.
+ */
+#ifndef IUI_WINDOW_H
+#define IUI_WINDOW_H
+
+#include "iui/iui.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct iui_window_set iui_window_set;
+typedef uint32_t iui_window;
+
+#define IUI_INVALID_WINDOW ((iui_window)0xffffffffu)
+
+/* Called on the window's own thread, once per kicked frame (or once for
+ * a run of frames if the display is slower than the declaration loop). */
+typedef void (*iui_present_fn)(iui_window win, iui_context *ctx,
+                               void *user);
+
+IUI_API iui_window_set *iui_window_set_create(void);
+/* Joins all present threads, then destroys the windows' contexts. */
+IUI_API void iui_window_set_destroy(iui_window_set *ws);
+
+IUI_API iui_window iui_window_add(iui_window_set *ws, float width,
+                                  float height);
+IUI_API iui_status iui_window_resize(iui_window_set *ws, iui_window win,
+                                     float width, float height);
+
+/* The window's context: declare its frame through the normal API with
+ * the size last given to add/resize (iui_window_size reads it back). */
+IUI_API iui_context *iui_window_context(iui_window_set *ws, iui_window win);
+IUI_API iui_status iui_window_size(const iui_window_set *ws, iui_window win,
+                                   float *width, float *height);
+
+/* Install the present callback and start the window's thread.  NULL fn
+ * stops the thread (joining it) — do this before releasing anything the
+ * callback touches. */
+IUI_API iui_status iui_window_set_present(iui_window_set *ws, iui_window win,
+                                          iui_present_fn fn, void *user);
+
+/* Wake every present thread for one more frame; never blocks. */
+IUI_API void iui_window_set_kick(iui_window_set *ws);
+
+/* Block until every kicked frame has been presented (shutdown, vsync
+ * re-sync points). */
+IUI_API void iui_window_set_wait(iui_window_set *ws);
+
+/* Frames actually presented by this window — lags the kick count on a
+ * slow display. */
+IUI_API uint64_t iui_window_presented(const iui_window_set *ws,
+                                      iui_window win);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* IUI_WINDOW_H */
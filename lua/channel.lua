@@ -0,0 +1,77 @@
+-- channel.lua — Lua side of the SPSC update channel.
+--
+-- Mirrors the ring protocol from include/iui/channel.h so a LuaJIT data
+-- thread can publish fixed-size records with plain stores, no C call per
+-- record.  Counter stores here rely on x86/TSO store ordering (the
+-- record bytes are written before the head bump and LuaJIT does not
+-- reorder those stores); on weakly ordered targets publish through
+-- iui_channel_push instead.
+--
+--   local channel = require("channel")
+--   local ch = channel.open(ffi.cast("iui_channel_shared *", view), "iui_quote")
+--   ch:push(quote)            -- data thread
+--   ch:drain(handler)         -- frame loop
+
+local ffi = require("ffi")
+local band = bit.band
+
+ffi.cdef [[
+typedef struct iui_channel_shared {
+    uint32_t capacity;
+    uint32_t record_size;
+    uint32_t reserved[14];
+    uint32_t head;
+    uint32_t pad_head[15];
+    uint32_t tail;
+    uint32_t pad_tail[15];
+} iui_channel_shared;
+]]
+
+local M = {}
+local ring = {}
+ring.__index = ring
+
+-- view: iui_channel_shared* (from iui_channel_view, passed across threads
+-- as a number or lightuserdata).  ctype: name of the record struct, which
+-- must be exactly record_size bytes.
+function M.open(view, ctype)
+    local self = setmetatable({}, ring)
+    self.shared = ffi.cast("iui_channel_shared *", view)
+    self.records = ffi.cast(ctype .. " *",
+                            ffi.cast("uint8_t *", self.shared) +
+                                ffi.sizeof("iui_channel_shared"))
+    self.mask = self.shared.capacity - 1
+    assert(ffi.sizeof(ctype) == self.shared.record_size,
+           "record ctype size does not match channel record_size")
+    return self
+end
+
+-- Producer only.  Returns false when the ring is full.
+function ring:push(record)
+    local s = self.shared
+    local head = s.head
+    if head - s.tail == s.capacity then
+        return false
+    end
+    self.records[band(head, self.mask)] = record
+    s.head = head + 1 -- publish; record bytes stored above
+    return true
+end
+
+-- Consumer only.  Calls fn(record) for up to max queued records (default:
+-- all); records are only valid during the call.  Returns the count.
+function ring:drain(fn, max)
+    local s = self.shared
+    local tail = s.tail
+    local n = s.head - tail
+    if max and n > max then n = max end
+    for i = 0, n - 1 do
+        fn(self.records[band(tail + i, self.mask)])
+    end
+    if n > 0 then
+        s.tail = tail + n
+    end
+    return n
+end
+
+return M
@@ -0,0 +1,94 @@
+-- iui_core.lua — LuaJIT FFI binding for the native libiui core.
+--
+-- Loaded by the Launcher.cmd / Launch.bat bundles; the Lua side keeps
+-- driving high-level composition while the widget walk, layout and
+-- hit-testing run inside iui_core.  The cdef below must stay in sync with
+-- include/iui/iui.h.
+
+local ffi = require("ffi")
+
+ffi.cdef [[
+typedef struct iui_context iui_context;
+typedef uint32_t iui_widget;
+typedef struct iui_rect { float x, y, w, h; } iui_rect;
+typedef enum iui_axis { IUI_AXIS_COLUMN = 0, IUI_AXIS_ROW = 1 } iui_axis;
+
+iui_context *iui_context_create(void);
+void iui_context_destroy(iui_context *ctx);
+int iui_frame_begin(iui_context *ctx, float width, float height);
+int iui_frame_end(iui_context *ctx);
+iui_widget iui_widget_begin(iui_context *ctx, const char *id);
+int iui_widget_end(iui_context *ctx);
+int iui_widget_set_size(iui_context *ctx, float w, float h);
+int iui_widget_set_axis(iui_context *ctx, iui_axis axis);
+int iui_widget_set_padding(iui_context *ctx, float padding);
+int iui_widget_set_spacing(iui_context *ctx, float spacing);
+int iui_widget_bounds(const iui_context *ctx, iui_widget w, iui_rect *out);
+uint32_t iui_widget_count(const iui_context *ctx);
+iui_widget iui_hit_test(const iui_context *ctx, float x, float y);
+
+typedef uint32_t iui_str;
+iui_str iui_intern(const char *s, size_t len);
+iui_widget iui_widget_begin_h(iui_context *ctx, iui_str id);
+
+typedef struct iui_style {
+    uint32_t bg_color, fg_color, border_color;
+    float border_width, corner_radius, padding, spacing;
+    uint32_t font;
+} iui_style;
+typedef struct iui_theme { iui_style styles[6][4]; } iui_theme;
+const iui_theme *iui_theme_default(void);
+void iui_context_set_theme(iui_context *ctx, const iui_theme *t);
+const iui_theme *iui_context_theme(const iui_context *ctx);
+]]
+
+local lib_name = ffi.os == "Windows" and "iui_core.dll" or "libiui_core.so"
+local C = ffi.load(lib_name)
+
+local M = { C = C }
+
+M.SIZE_FILL = -1.0
+M.SIZE_FIT = -2.0
+
+-- Widget kinds / states, indices into iui_theme.styles.  Style lookup from
+-- Lua is plain array indexing on the precompiled table — no hashing, no
+-- call back into C:
+--   local s = theme.styles[M.KIND_BUTTON][M.STATE_HOVER]
+M.KIND_PANEL, M.KIND_BUTTON, M.KIND_LABEL = 0, 1, 2
+M.KIND_INPUT, M.KIND_LIST_ROW, M.KIND_SCROLLBAR = 3, 4, 5
+M.STATE_NORMAL, M.STATE_HOVER, M.STATE_ACTIVE, M.STATE_DISABLED = 0, 1, 2, 3
+
+M.default_theme = C.iui_theme_default()
+
+function M.new_context()
+    local ctx = C.iui_context_create()
+    return ffi.gc(ctx, C.iui_context_destroy)
+end
+
+-- Memoized interning: resolve each ID/label string to its handle once,
+-- then call sites pass plain integers every frame.
+--   local id = iui.intern("sidebar")   -- once, at module scope
+--   C.iui_widget_begin_h(ctx, id)      -- per frame, no hashing
+local interned = setmetatable({}, {
+    __index = function(t, s)
+        local h = C.iui_intern(s, #s)
+        rawset(t, s, h)
+        return h
+    end,
+})
+
+function M.intern(s)
+    return interned[s]
+end
+
+-- Scratch rect reused across calls to keep the frame loop allocation-free.
+local scratch_rect = ffi.new("iui_rect")
+
+function M.bounds(ctx, widget)
+    if C.iui_widget_bounds(ctx, widget, scratch_rect) ~= 0 then
+        return nil
+    end
+    return scratch_rect.x, scratch_rect.y, scratch_rect.w, scratch_rect.h
+end
+
+return M
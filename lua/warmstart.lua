@@ -0,0 +1,95 @@
+-- warmstart.lua — bring the LuaJIT runtime to steady-state speed at launch.
+--
+-- LuaJIT cannot serialize compiled traces, so warm start is two cheaper
+-- substitutes baked into the bundle at build time:
+--
+--   warm/<module>.ljbc   precompiled bytecode (luajit -b), loaded straight
+--                        out of the mapped bundle — no parse, no compile
+--   warm/seeds.jsonl     one {"module":M,"fn":F,"calls":N} per line; each
+--                        listed function is driven N times before the
+--                        first real frame so the hot traces exist when the
+--                        user is watching
+--
+-- Typical use from the launcher, before the first frame:
+--
+--   local warm = require("warmstart")
+--   warm.run(bundle_handle)
+
+local ffi = require("ffi")
+
+ffi.cdef [[
+typedef struct iui_bundle iui_bundle;
+const void *iui_bundle_find_prefix(const iui_bundle *b, const char *prefix,
+                                   uint32_t index, const char **name_out,
+                                   uint64_t *size_out);
+void iui_startup_mark(const char *phase);
+]]
+
+local lib_name = ffi.os == "Windows" and "iui_core.dll" or "libiui_core.so"
+local C = ffi.load(lib_name)
+
+local M = {}
+
+local name_out = ffi.new("const char *[1]")
+local size_out = ffi.new("uint64_t[1]")
+
+-- Load every warm/*.ljbc chunk and register it in package.loaded under its
+-- module name, so later require() calls are free.
+function M.preload(bundle)
+    local loaded = {}
+    local index = 0
+    while true do
+        local data = C.iui_bundle_find_prefix(bundle, "warm/", index,
+                                              name_out, size_out)
+        if data == nil then break end
+        index = index + 1
+        local name = ffi.string(name_out[0])
+        local modname = name:match("^warm/(.+)%.ljbc$")
+        if modname then
+            local chunk = ffi.string(data, tonumber(size_out[0]))
+            local fn, err = loadstring(chunk, "@" .. name)
+            if fn then
+                package.loaded[modname] = fn()
+                loaded[#loaded + 1] = modname
+            else
+                io.stderr:write("warmstart: bad bytecode ", name, ": ",
+                                tostring(err), "\n")
+            end
+        end
+    end
+    return loaded
+end
+
+-- Drive the seed functions so the JIT compiles their traces now rather
+-- than during the first interactive frames.
+function M.seed(bundle)
+    local data = C.iui_bundle_find_prefix(bundle, "warm/seeds.jsonl", 0,
+                                          nil, size_out)
+    if data == nil then return 0 end
+    local text = ffi.string(data, tonumber(size_out[0]))
+    local seeded = 0
+    for line in text:gmatch("[^\n]+") do
+        local modname = line:match('"module"%s*:%s*"([^"]+)"')
+        local fname = line:match('"fn"%s*:%s*"([^"]+)"')
+        local calls = tonumber(line:match('"calls"%s*:%s*(%d+)')) or 100
+        local mod = modname and package.loaded[modname]
+        local fn = mod and mod[fname]
+        if type(fn) == "function" then
+            for _ = 1, calls do
+                pcall(fn)
+            end
+            seeded = seeded + 1
+        end
+    end
+    return seeded
+end
+
+function M.run(bundle)
+    local mods = M.preload(bundle)
+    C.iui_startup_mark("warm.preload")
+    local seeds = M.seed(bundle)
+    C.iui_startup_mark("warm.seed")
+    return #mods, seeds
+end
+
+return M
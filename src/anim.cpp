@@ -0,0 +1,136 @@
+// anim.cpp — batched timeline advance for animated store properties.
+//
+// Active timelines are kept in parallel flat arrays (slot, prop,
+// endpoints, clock) and advanced in one pass per frame: compute the
+// normalized time, apply the curve branch-free on the polynomial forms,
+// lerp, scatter into the store column.  The pass is bound by the
+// scattered column writes, not the arithmetic, so the arrays stay in
+// declaration order and finished timelines are swap-removed.
+
+#include "iui/anim.h"
+
+#include "context.h"
+
+namespace {
+
+float *prop_column(iui_context &ctx, iui_anim_prop prop) {
+    switch (prop) {
+    case IUI_ANIM_SCROLL_X:
+        return ctx.store.scroll_x.data();
+    case IUI_ANIM_SCROLL_Y:
+        return ctx.store.scroll_y.data();
+    default:
+        return ctx.store.anim.data();
+    }
+}
+
+float apply_curve(uint32_t curve, float t) {
+    // All four curves as one polynomial family keeps the loop branch-light:
+    // linear t, ease-in t^2, ease-out 1-(1-t)^2, smoothstep 3t^2 - 2t^3.
+    switch (curve) {
+    case IUI_CURVE_EASE_IN:
+        return t * t;
+    case IUI_CURVE_EASE_OUT:
+        return 1.0f - (1.0f - t) * (1.0f - t);
+    case IUI_CURVE_EASE_IN_OUT:
+        return t * t * (3.0f - 2.0f * t);
+    default:
+        return t;
+    }
+}
+
+} // namespace
+
+namespace iui {
+
+void anim_advance(iui_context &ctx) {
+    anim_state &a = ctx.anim;
+    uint64_t now = now_us();
+    uint32_t store_size = ctx.store.size();
+    for (uint32_t i = 0; i < a.slot.size();) {
+        if (a.slot[i] >= store_size) {
+            // Slot was recycled out from under the timeline; drop it.
+            a.swap_remove(i);
+            continue;
+        }
+        float t = a.end_us[i] > a.start_us[i]
+                      ? (float)(now - a.start_us[i]) /
+                            (float)(a.end_us[i] - a.start_us[i])
+                      : 1.0f;
+        bool done = t >= 1.0f;
+        if (done)
+            t = 1.0f;
+        float eased = apply_curve(a.curve[i], t);
+        prop_column(ctx, (iui_anim_prop)a.prop[i])[a.slot[i]] =
+            a.from[i] + (a.to[i] - a.from[i]) * eased;
+        if (done)
+            a.swap_remove(i);
+        else
+            ++i;
+    }
+}
+
+} // namespace iui
+
+extern "C" {
+
+iui_status iui_anim_start(iui_context *ctx, iui_slot slot,
+                          iui_anim_prop prop, float from, float to,
+                          float duration_ms, iui_anim_curve curve) {
+    if (!ctx || slot >= ctx->store.size() ||
+        (uint32_t)prop >= IUI_ANIM_PROP_COUNT)
+        return IUI_ERR_INVALID_ARG;
+    if (duration_ms <= 0.0f) {
+        prop_column(*ctx, prop)[slot] = to;
+        iui_anim_stop(ctx, slot, prop);
+        return IUI_OK;
+    }
+    iui::anim_state &a = ctx->anim;
+    uint64_t now = iui::now_us();
+    uint64_t end = now + (uint64_t)(duration_ms * 1000.0f);
+    // One timeline per (slot, prop): restarting replaces in place.
+    for (size_t i = 0; i < a.slot.size(); ++i) {
+        if (a.slot[i] == slot && a.prop[i] == (uint32_t)prop) {
+            a.from[i] = from;
+            a.to[i] = to;
+            a.start_us[i] = now;
+            a.end_us[i] = end;
+            a.curve[i] = (uint32_t)curve;
+            return IUI_OK;
+        }
+    }
+    a.slot.push_back(slot);
+    a.prop.push_back((uint32_t)prop);
+    a.from.push_back(from);
+    a.to.push_back(to);
+    a.start_us.push_back(now);
+    a.end_us.push_back(end);
+    a.curve.push_back((uint32_t)curve);
+    return IUI_OK;
+}
+
+iui_status iui_anim_stop(iui_context *ctx, iui_slot slot,
+                         iui_anim_prop prop) {
+    if (!ctx)
+        return IUI_ERR_INVALID_ARG;
+    iui::anim_state &a = ctx->anim;
+    for (size_t i = 0; i < a.slot.size(); ++i) {
+        if (a.slot[i] == slot && a.prop[i] == (uint32_t)prop) {
+            a.swap_remove((uint32_t)i);
+            return IUI_OK;
+        }
+    }
+    return IUI_OK; // stopping a finished animation is not an error
+}
+
+uint32_t iui_anim_active(const iui_context *ctx) {
+    return ctx ? (uint32_t)ctx->anim.slot.size() : 0;
+}
+
+float iui_slot_anim_value(const iui_context *ctx, iui_slot slot) {
+    if (!ctx || slot >= ctx->store.size())
+        return 0.0f;
+    return ctx->store.anim[slot];
+}
+
+} // extern "C"
@@ -0,0 +1,123 @@
+// arena.cpp — bump allocation and the iui_arena / frame-arena C API.
+
+#include "arena.h"
+
+#include "context.h"
+#include "iui/arena.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+namespace iui {
+
+arena::~arena() {
+    for (block &b : blocks_)
+        free(b.base);
+}
+
+void *arena::alloc(size_t size, size_t align) {
+    if (align == 0)
+        align = 16;
+    if (!blocks_.empty()) {
+        block &b = blocks_.back();
+        size_t aligned = (b.cursor + align - 1) & ~(align - 1);
+        if (aligned + size <= b.size) {
+            b.cursor = aligned + size;
+            used_ += size;
+            return b.base + aligned;
+        }
+    }
+    // Grow: double the last block so repeated overflow settles quickly,
+    // and always fit the request.
+    size_t next = blocks_.empty() ? block_size_ : blocks_.back().size * 2;
+    if (next < size + align)
+        next = size + align;
+    uint8_t *base = (uint8_t *)malloc(next);
+    if (!base)
+        return nullptr;
+    size_t aligned = ((uintptr_t)base % align)
+                         ? align - (uintptr_t)base % align
+                         : 0;
+    blocks_.push_back(block{base, next, aligned + size});
+    used_ += size;
+    return base + aligned;
+}
+
+void arena::reset() {
+    used_ = 0;
+    if (blocks_.empty())
+        return;
+    // Keep only the largest block; in steady state that is the only one.
+    size_t largest = 0;
+    for (size_t i = 1; i < blocks_.size(); ++i)
+        if (blocks_[i].size > blocks_[largest].size)
+            largest = i;
+    block keep = blocks_[largest];
+    for (size_t i = 0; i < blocks_.size(); ++i)
+        if (i != largest)
+            free(blocks_[i].base);
+    keep.cursor = 0;
+    blocks_.clear();
+    blocks_.push_back(keep);
+}
+
+} // namespace iui
+
+struct iui_arena {
+    iui::arena impl;
+    explicit iui_arena(size_t block_size) : impl(block_size) {}
+};
+
+extern "C" {
+
+iui_arena *iui_arena_create(size_t block_size) {
+    return new (std::nothrow) iui_arena(block_size);
+}
+
+void iui_arena_destroy(iui_arena *a) {
+    delete a;
+}
+
+void *iui_arena_alloc(iui_arena *a, size_t size, size_t align) {
+    if (!a || !size || (align & (align - 1)))
+        return nullptr;
+    return a->impl.alloc(size, align);
+}
+
+char *iui_arena_strdup(iui_arena *a, const char *s) {
+    if (!a || !s)
+        return nullptr;
+    size_t len = strlen(s) + 1;
+    char *copy = (char *)a->impl.alloc(len, 1);
+    if (copy)
+        memcpy(copy, s, len);
+    return copy;
+}
+
+void iui_arena_reset(iui_arena *a) {
+    if (a)
+        a->impl.reset();
+}
+
+size_t iui_arena_used(const iui_arena *a) {
+    return a ? a->impl.used() : 0;
+}
+
+void *iui_frame_alloc(iui_context *ctx, size_t size, size_t align) {
+    if (!ctx || !size || (align & (align - 1)))
+        return nullptr;
+    return ctx->frame_arena.alloc(size, align);
+}
+
+char *iui_frame_strdup(iui_context *ctx, const char *s) {
+    if (!ctx || !s)
+        return nullptr;
+    size_t len = strlen(s) + 1;
+    char *copy = (char *)ctx->frame_arena.alloc(len, 1);
+    if (copy)
+        memcpy(copy, s, len);
+    return copy;
+}
+
+} // extern "C"
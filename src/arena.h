@@ -0,0 +1,39 @@
+// arena.h — internal bump-allocator class behind the iui_arena C API.
+#ifndef IUI_SRC_ARENA_H
+#define IUI_SRC_ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace iui {
+
+class arena {
+  public:
+    static constexpr size_t kDefaultBlock = 256 * 1024;
+
+    explicit arena(size_t block_size = kDefaultBlock)
+        : block_size_(block_size ? block_size : kDefaultBlock) {}
+    ~arena();
+    arena(const arena &) = delete;
+    arena &operator=(const arena &) = delete;
+
+    void *alloc(size_t size, size_t align);
+    void reset();
+    size_t used() const { return used_; }
+
+  private:
+    struct block {
+        uint8_t *base;
+        size_t size;
+        size_t cursor;
+    };
+
+    std::vector<block> blocks_;
+    size_t block_size_;
+    size_t used_ = 0;
+};
+
+} // namespace iui
+
+#endif // IUI_SRC_ARENA_H
@@ -0,0 +1,148 @@
+// buffer.cpp — refcounted buffers and the clipboard/DnD channels.
+
+#include "iui/buffer.h"
+
+#include "context.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+struct iui_buffer {
+    void *data;
+    size_t size;
+    std::atomic<int> refs;
+    void (*release)(void *user, void *data);
+    void *user;
+    bool owned; // allocated by iui_buffer_create
+};
+
+namespace {
+
+void channel_set(std::vector<iui_context::mime_entry> &channel,
+                 const char *mime, iui_buffer *b) {
+    uint64_t key = iui::hash_id(mime);
+    for (auto &e : channel) {
+        if (e.mime_hash == key) {
+            iui_buffer_unref(e.buffer);
+            e.buffer = b;
+            return;
+        }
+    }
+    channel.push_back(iui_context::mime_entry{key, b});
+}
+
+iui_buffer *channel_get(const std::vector<iui_context::mime_entry> &channel,
+                        const char *mime) {
+    uint64_t key = iui::hash_id(mime);
+    for (const auto &e : channel) {
+        if (e.mime_hash == key) {
+            iui_buffer_ref(e.buffer);
+            return e.buffer;
+        }
+    }
+    return nullptr;
+}
+
+void channel_clear(std::vector<iui_context::mime_entry> &channel) {
+    for (auto &e : channel)
+        iui_buffer_unref(e.buffer);
+    channel.clear();
+}
+
+} // namespace
+
+namespace iui {
+
+void release_channels(iui_context &ctx) {
+    channel_clear(ctx.clipboard);
+    channel_clear(ctx.dnd);
+}
+
+} // namespace iui
+
+extern "C" {
+
+iui_buffer *iui_buffer_create(size_t size) {
+    if (!size)
+        return nullptr;
+    void *data = calloc(1, size);
+    if (!data)
+        return nullptr;
+    iui_buffer *b = new (std::nothrow) iui_buffer{data, size, {1}, nullptr,
+                                                  nullptr, true};
+    if (!b)
+        free(data);
+    return b;
+}
+
+iui_buffer *iui_buffer_wrap(void *data, size_t size,
+                            void (*release)(void *user, void *data),
+                            void *user) {
+    if (!data || !size)
+        return nullptr;
+    return new (std::nothrow) iui_buffer{data, size, {1}, release, user,
+                                         false};
+}
+
+void *iui_buffer_data(iui_buffer *b) {
+    return b ? b->data : nullptr;
+}
+
+size_t iui_buffer_size(const iui_buffer *b) {
+    return b ? b->size : 0;
+}
+
+void iui_buffer_ref(iui_buffer *b) {
+    if (b)
+        b->refs.fetch_add(1, std::memory_order_relaxed);
+}
+
+void iui_buffer_unref(iui_buffer *b) {
+    if (!b)
+        return;
+    if (b->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        if (b->owned)
+            free(b->data);
+        else if (b->release)
+            b->release(b->user, b->data);
+        delete b;
+    }
+}
+
+iui_status iui_clipboard_set(iui_context *ctx, const char *mime,
+                             iui_buffer *b) {
+    if (!ctx || !mime || !b)
+        return IUI_ERR_INVALID_ARG;
+    iui_buffer_ref(b);
+    channel_set(ctx->clipboard, mime, b);
+    return IUI_OK;
+}
+
+iui_buffer *iui_clipboard_get(iui_context *ctx, const char *mime) {
+    if (!ctx || !mime)
+        return nullptr;
+    return channel_get(ctx->clipboard, mime);
+}
+
+iui_status iui_dnd_begin(iui_context *ctx, const char *mime, iui_buffer *b) {
+    if (!ctx || !mime || !b)
+        return IUI_ERR_INVALID_ARG;
+    iui_buffer_ref(b);
+    channel_set(ctx->dnd, mime, b);
+    return IUI_OK;
+}
+
+iui_buffer *iui_dnd_payload(iui_context *ctx, const char *mime) {
+    if (!ctx || !mime)
+        return nullptr;
+    return channel_get(ctx->dnd, mime);
+}
+
+void iui_dnd_end(iui_context *ctx) {
+    if (ctx)
+        channel_clear(ctx->dnd);
+}
+
+} // extern "C"
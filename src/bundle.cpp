@@ -0,0 +1,135 @@
+// bundle.cpp — mapping and lookup for the IUIB bundle format.
+
+#include "iui/bundle.h"
+
+#include "iui/startup.h"
+
+#include "mapped_file.h"
+
+#include <cstring>
+#include <new>
+
+struct iui_bundle {
+    iui::mapped_file file;
+    const uint8_t *base = nullptr;
+    uint64_t size = 0;
+};
+
+namespace {
+
+const iui_bundle_header *header(const iui_bundle *b) {
+    return (const iui_bundle_header *)b->base;
+}
+
+const iui_bundle_entry *entries(const iui_bundle *b) {
+    return (const iui_bundle_entry *)(b->base + sizeof(iui_bundle_header));
+}
+
+// Reject anything that would make a lookup read outside the mapping; a
+// truncated or tampered bundle must fail at open, not at use.
+bool validate(const iui_bundle *b) {
+    if (b->size < sizeof(iui_bundle_header))
+        return false;
+    const iui_bundle_header *h = header(b);
+    if (h->magic != IUI_BUNDLE_MAGIC || h->version != IUI_BUNDLE_VERSION)
+        return false;
+    if (h->file_size != b->size)
+        return false;
+    uint64_t table_end = sizeof(iui_bundle_header) +
+                         (uint64_t)h->entry_count * sizeof(iui_bundle_entry);
+    if (table_end > b->size)
+        return false;
+    const iui_bundle_entry *e = entries(b);
+    for (uint32_t i = 0; i < h->entry_count; ++i) {
+        if (e[i].name_offset >= b->size)
+            return false;
+        if (e[i].data_offset % IUI_BUNDLE_PAGE != 0)
+            return false;
+        if (e[i].data_offset > b->size || e[i].size > b->size - e[i].data_offset)
+            return false;
+        // Name must terminate inside the file.
+        const void *nul = memchr(b->base + e[i].name_offset, 0,
+                                 b->size - e[i].name_offset);
+        if (!nul)
+            return false;
+    }
+    return true;
+}
+
+} // namespace
+
+extern "C" {
+
+iui_bundle *iui_bundle_open(const char *path) {
+    if (!path)
+        return nullptr;
+    iui_bundle *b = new (std::nothrow) iui_bundle();
+    if (!b)
+        return nullptr;
+    if (!b->file.map(path)) {
+        delete b;
+        return nullptr;
+    }
+    b->base = b->file.data();
+    b->size = b->file.size();
+    if (!validate(b)) {
+        iui_bundle_close(b);
+        return nullptr;
+    }
+    iui_startup_mark("core.bundle_open");
+    return b;
+}
+
+void iui_bundle_close(iui_bundle *b) {
+    delete b;
+}
+
+uint32_t iui_bundle_entry_count(const iui_bundle *b) {
+    return b ? header(b)->entry_count : 0;
+}
+
+const char *iui_bundle_entry_name(const iui_bundle *b, uint32_t index) {
+    if (!b || index >= header(b)->entry_count)
+        return nullptr;
+    return (const char *)(b->base + entries(b)[index].name_offset);
+}
+
+const void *iui_bundle_find_prefix(const iui_bundle *b, const char *prefix,
+                                   uint32_t index, const char **name_out,
+                                   uint64_t *size_out) {
+    if (!b || !prefix)
+        return nullptr;
+    size_t prefix_len = strlen(prefix);
+    const iui_bundle_entry *e = entries(b);
+    uint32_t seen = 0;
+    for (uint32_t i = 0; i < header(b)->entry_count; ++i) {
+        const char *name = (const char *)(b->base + e[i].name_offset);
+        if (strncmp(name, prefix, prefix_len) != 0)
+            continue;
+        if (seen++ != index)
+            continue;
+        if (name_out)
+            *name_out = name;
+        if (size_out)
+            *size_out = e[i].size;
+        return b->base + e[i].data_offset;
+    }
+    return nullptr;
+}
+
+const void *iui_bundle_find(const iui_bundle *b, const char *name,
+                            uint64_t *size_out) {
+    if (!b || !name)
+        return nullptr;
+    const iui_bundle_entry *e = entries(b);
+    for (uint32_t i = 0; i < header(b)->entry_count; ++i) {
+        if (strcmp((const char *)(b->base + e[i].name_offset), name) == 0) {
+            if (size_out)
+                *size_out = e[i].size;
+            return b->base + e[i].data_offset;
+        }
+    }
+    return nullptr;
+}
+
+} // extern "C"
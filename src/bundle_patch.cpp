@@ -0,0 +1,96 @@
+// bundle_patch.cpp — patch application for the updater mode.
+
+#include "iui/patch.h"
+
+#include "mapped_file.h"
+
+#include <cstdio>
+#include <cstring>
+
+namespace iui {
+
+uint64_t fnv1a(const uint8_t *data, uint64_t size) {
+    uint64_t h = 1469598103934665603ull;
+    for (uint64_t i = 0; i < size; ++i) {
+        h ^= data[i];
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+} // namespace iui
+
+extern "C" {
+
+iui_status iui_patch_apply(const char *old_path, const char *patch_path,
+                           const char *out_path) {
+    if (!old_path || !patch_path || !out_path)
+        return IUI_ERR_INVALID_ARG;
+
+    iui::mapped_file old_file, patch;
+    if (!old_file.map(old_path) || !patch.map(patch_path))
+        return IUI_ERR_IO;
+    if (patch.size() < sizeof(iui_patch_header))
+        return IUI_ERR_CORRUPT;
+    const iui_patch_header *h = (const iui_patch_header *)patch.data();
+    if (h->magic != IUI_PATCH_MAGIC || h->version != IUI_PATCH_VERSION)
+        return IUI_ERR_CORRUPT;
+
+    FILE *out = fopen(out_path, "wb");
+    if (!out)
+        return IUI_ERR_IO;
+
+    // Stream records, hashing output as we go so verification needs no
+    // second pass over the (potentially large) result.
+    uint64_t hash = 1469598103934665603ull;
+    uint64_t written = 0;
+    uint64_t cursor = sizeof(iui_patch_header);
+    iui_status st = IUI_OK;
+    for (uint64_t r = 0; r < h->record_count && st == IUI_OK; ++r) {
+        if (cursor + sizeof(iui_patch_record) > patch.size()) {
+            st = IUI_ERR_CORRUPT;
+            break;
+        }
+        iui_patch_record rec;
+        memcpy(&rec, patch.data() + cursor, sizeof(rec));
+        cursor += sizeof(rec);
+
+        const uint8_t *src;
+        if (rec.op == IUI_PATCH_COPY) {
+            if (rec.offset > old_file.size() ||
+                rec.length > old_file.size() - rec.offset) {
+                st = IUI_ERR_CORRUPT;
+                break;
+            }
+            src = old_file.data() + rec.offset;
+        } else if (rec.op == IUI_PATCH_INSERT) {
+            if (cursor + rec.length > patch.size()) {
+                st = IUI_ERR_CORRUPT;
+                break;
+            }
+            src = patch.data() + cursor;
+            cursor += rec.length;
+        } else {
+            st = IUI_ERR_CORRUPT;
+            break;
+        }
+        if (fwrite(src, 1, rec.length, out) != rec.length) {
+            st = IUI_ERR_IO;
+            break;
+        }
+        for (uint64_t i = 0; i < rec.length; ++i) {
+            hash ^= src[i];
+            hash *= 1099511628211ull;
+        }
+        written += rec.length;
+    }
+    if (fclose(out) != 0 && st == IUI_OK)
+        st = IUI_ERR_IO;
+    if (st == IUI_OK && (written != h->new_size || hash != h->new_hash))
+        st = IUI_ERR_CORRUPT;
+    if (st != IUI_OK)
+        remove(out_path);
+    return st;
+}
+
+} // extern "C"
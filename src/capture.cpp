@@ -0,0 +1,124 @@
+// capture.cpp — background flush from the capture ring to an IUIT trace.
+//
+// The frame-loop side is iui_channel_push into a preallocated ring; all
+// file I/O lives on the flush thread, which drains in batches and parks
+// on a condition variable with a short timeout when the ring runs dry
+// (the timeout covers the race between a push and the wakeup without
+// requiring the producer to signal on every event — one notify per frame
+// mark is enough to keep latency at a frame).
+
+#include "iui/capture.h"
+
+#include "iui/channel.h"
+
+#include "context.h" // now_us, capture attachment
+
+#include <atomic>
+#include <condition_variable>
+#include <chrono>
+#include <mutex>
+#include <new>
+#include <thread>
+
+namespace {
+
+constexpr uint32_t kDefaultRing = 16384;
+constexpr uint32_t kFlushBatch = 256;
+
+} // namespace
+
+struct iui_capture {
+    iui_channel *ring = nullptr;
+    iui_trace_writer *writer = nullptr;
+    std::thread flusher;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::atomic<uint64_t> dropped{0};
+    bool stop = false;
+};
+
+namespace {
+
+void flush_loop(iui_capture *cap) {
+    iui_event batch[kFlushBatch];
+    for (;;) {
+        uint32_t n = iui_channel_drain(cap->ring, batch, kFlushBatch);
+        for (uint32_t i = 0; i < n; ++i)
+            iui_trace_write(cap->writer, &batch[i]);
+        if (n == kFlushBatch)
+            continue; // ring still hot, keep draining
+        std::unique_lock<std::mutex> lock(cap->mutex);
+        if (cap->stop && iui_channel_pending(cap->ring) == 0)
+            return;
+        cap->wake.wait_for(lock, std::chrono::milliseconds(5));
+    }
+}
+
+} // namespace
+
+extern "C" {
+
+iui_capture *iui_capture_start(const char *path, uint32_t ring_records) {
+    if (!path)
+        return nullptr;
+    iui_capture *cap = new (std::nothrow) iui_capture();
+    if (!cap)
+        return nullptr;
+    cap->ring = iui_channel_create(
+        sizeof(iui_event), ring_records ? ring_records : kDefaultRing);
+    cap->writer = iui_trace_writer_open(path);
+    if (!cap->ring || !cap->writer) {
+        if (cap->writer)
+            iui_trace_writer_close(cap->writer);
+        iui_channel_destroy(cap->ring);
+        delete cap;
+        return nullptr;
+    }
+    cap->flusher = std::thread(flush_loop, cap);
+    return cap;
+}
+
+iui_status iui_capture_stop(iui_capture *cap) {
+    if (!cap)
+        return IUI_ERR_INVALID_ARG;
+    {
+        std::lock_guard<std::mutex> lock(cap->mutex);
+        cap->stop = true;
+    }
+    cap->wake.notify_all();
+    cap->flusher.join();
+    iui_status st = iui_trace_writer_close(cap->writer);
+    iui_channel_destroy(cap->ring);
+    delete cap;
+    return st;
+}
+
+void iui_capture_record(iui_capture *cap, const iui_event *e) {
+    if (!cap || !e)
+        return;
+    if (iui_channel_push(cap->ring, e) != IUI_OK)
+        cap->dropped.fetch_add(1, std::memory_order_relaxed);
+}
+
+void iui_capture_frame_mark(iui_capture *cap) {
+    if (!cap)
+        return;
+    iui_event mark{};
+    mark.type = IUI_EVENT_FRAME_MARK;
+    mark.time_us = iui::now_us();
+    iui_capture_record(cap, &mark);
+    cap->wake.notify_one(); // bound flush latency to about a frame
+}
+
+iui_status iui_context_set_capture(iui_context *ctx, iui_capture *cap) {
+    if (!ctx)
+        return IUI_ERR_INVALID_ARG;
+    ctx->capture = cap;
+    return IUI_OK;
+}
+
+uint64_t iui_capture_dropped(const iui_capture *cap) {
+    return cap ? cap->dropped.load(std::memory_order_relaxed) : 0;
+}
+
+} // extern "C"
@@ -0,0 +1,114 @@
+// channel.cpp — the SPSC ring behind iui_channel.
+//
+// Classic two-counter ring: head and tail run free and are masked into
+// slots, so full (head - tail == capacity) and empty (head == tail) are
+// unambiguous without a spare slot.  The producer owns head, the consumer
+// owns tail; each side does an acquire load of the other's counter and a
+// release store of its own after the memcpy, which is the entire
+// synchronization protocol.  The counters sit on separate cache lines so
+// the two sides do not false-share.
+
+#include "iui/channel.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+struct iui_channel {
+    iui_channel_shared shared;
+    // records follow: capacity * record_size bytes
+};
+
+namespace {
+
+uint8_t *records(iui_channel *c) {
+    return (uint8_t *)c + sizeof(iui_channel_shared);
+}
+
+// The shared block is plain uint32_t for the FFI's sake; internally the
+// counters are accessed through atomic operations on those same bytes.
+std::atomic<uint32_t> &counter(uint32_t &v) {
+    static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t),
+                  "atomic counter must alias a plain uint32_t");
+    return *reinterpret_cast<std::atomic<uint32_t> *>(&v);
+}
+
+uint32_t round_pow2(uint32_t v) {
+    uint32_t p = 1;
+    while (p < v && p < 0x80000000u)
+        p <<= 1;
+    return p;
+}
+
+} // namespace
+
+extern "C" {
+
+iui_channel *iui_channel_create(uint32_t record_size, uint32_t capacity) {
+    if (record_size == 0 || capacity == 0)
+        return nullptr;
+    capacity = round_pow2(capacity);
+    if ((uint64_t)record_size * capacity > 1u << 30)
+        return nullptr; // refuse absurd rings rather than overflow
+    size_t size = sizeof(iui_channel_shared) + (size_t)record_size * capacity;
+    iui_channel *c = (iui_channel *)calloc(1, size);
+    if (!c)
+        return nullptr;
+    c->shared.capacity = capacity;
+    c->shared.record_size = record_size;
+    return c;
+}
+
+void iui_channel_destroy(iui_channel *c) {
+    free(c);
+}
+
+iui_status iui_channel_push(iui_channel *c, const void *record) {
+    if (!c || !record)
+        return IUI_ERR_INVALID_ARG;
+    iui_channel_shared &s = c->shared;
+    uint32_t head = counter(s.head).load(std::memory_order_relaxed);
+    uint32_t tail = counter(s.tail).load(std::memory_order_acquire);
+    if (head - tail == s.capacity)
+        return IUI_ERR_BAD_STATE; // full
+    memcpy(records(c) + (size_t)(head & (s.capacity - 1)) * s.record_size,
+           record, s.record_size);
+    counter(s.head).store(head + 1, std::memory_order_release);
+    return IUI_OK;
+}
+
+uint32_t iui_channel_drain(iui_channel *c, void *out, uint32_t max_records) {
+    if (!c || !out || max_records == 0)
+        return 0;
+    iui_channel_shared &s = c->shared;
+    uint32_t tail = counter(s.tail).load(std::memory_order_relaxed);
+    uint32_t head = counter(s.head).load(std::memory_order_acquire);
+    uint32_t n = head - tail;
+    if (n > max_records)
+        n = max_records;
+    uint8_t *dst = (uint8_t *)out;
+    for (uint32_t i = 0; i < n; ++i) {
+        memcpy(dst + (size_t)i * s.record_size,
+               records(c) +
+                   (size_t)((tail + i) & (s.capacity - 1)) * s.record_size,
+               s.record_size);
+    }
+    if (n)
+        counter(s.tail).store(tail + n, std::memory_order_release);
+    return n;
+}
+
+uint32_t iui_channel_pending(const iui_channel *c) {
+    if (!c)
+        return 0;
+    iui_channel_shared &s = const_cast<iui_channel *>(c)->shared;
+    return counter(s.head).load(std::memory_order_acquire) -
+           counter(s.tail).load(std::memory_order_acquire);
+}
+
+iui_channel_shared *iui_channel_view(iui_channel *c) {
+    return c ? &c->shared : nullptr;
+}
+
+} // extern "C"
@@ -0,0 +1,191 @@
+// cmd_buffer.cpp — recording, state sorting and batch building.
+//
+// Records carry a packed sort key (layer, scissor id, texture); finish
+// stable-sorts an index array over the records — the descriptors
+// themselves stay put — then tessellates in sorted order through the bulk
+// geometry kernel and cuts a batch wherever the key changes.  All storage
+// is retained across reset so a steady-state frame allocates nothing.
+
+#include "iui/render.h"
+
+#include <algorithm>
+#include <new>
+#include <vector>
+
+namespace {
+
+struct record {
+    iui_draw_desc desc;
+    uint64_t key; // layer:24 | scissor:16 | texture:24
+};
+
+uint64_t make_key(uint32_t layer, uint32_t scissor_id, uint32_t texture) {
+    return ((uint64_t)(layer & 0xffffffu) << 40) |
+           ((uint64_t)(scissor_id & 0xffffu) << 24) |
+           (uint64_t)(texture & 0xffffffu);
+}
+
+} // namespace
+
+struct iui_cmd_buffer {
+    std::vector<record> records;
+    std::vector<uint32_t> order; // sort permutation over records
+    std::vector<iui_rect> scissors; // id 0 = disabled
+    std::vector<iui_vertex> vertices;
+    std::vector<uint32_t> indices;
+    std::vector<iui_draw_batch> batches;
+    uint32_t layer = 0;
+    uint32_t scissor_id = 0;
+    bool finished = false;
+};
+
+extern "C" {
+
+iui_cmd_buffer *iui_cmd_buffer_create(void) {
+    iui_cmd_buffer *cb = new (std::nothrow) iui_cmd_buffer();
+    if (cb)
+        cb->scissors.push_back(iui_rect{}); // id 0: scissor off
+    return cb;
+}
+
+void iui_cmd_buffer_destroy(iui_cmd_buffer *cb) {
+    delete cb;
+}
+
+void iui_cmd_buffer_reset(iui_cmd_buffer *cb) {
+    if (!cb)
+        return;
+    cb->records.clear();
+    cb->order.clear();
+    cb->scissors.resize(1);
+    cb->vertices.clear();
+    cb->indices.clear();
+    cb->batches.clear();
+    cb->layer = 0;
+    cb->scissor_id = 0;
+    cb->finished = false;
+}
+
+void iui_cmd_set_layer(iui_cmd_buffer *cb, uint32_t layer) {
+    if (cb)
+        cb->layer = layer;
+}
+
+void iui_cmd_set_scissor(iui_cmd_buffer *cb, const iui_rect *rect) {
+    if (!cb)
+        return;
+    if (!rect) {
+        cb->scissor_id = 0;
+        return;
+    }
+    cb->scissors.push_back(*rect);
+    cb->scissor_id = (uint32_t)cb->scissors.size() - 1;
+}
+
+iui_status iui_cmd_rect(iui_cmd_buffer *cb, const iui_draw_desc *desc) {
+    if (!cb || !desc)
+        return IUI_ERR_INVALID_ARG;
+    if (cb->finished)
+        return IUI_ERR_BAD_STATE;
+    record r;
+    r.desc = *desc;
+    r.key = make_key(cb->layer, cb->scissor_id, desc->texture);
+    cb->records.push_back(r);
+    return IUI_OK;
+}
+
+iui_status iui_cmd_buffer_finish(iui_cmd_buffer *cb) {
+    if (!cb)
+        return IUI_ERR_INVALID_ARG;
+    if (cb->finished)
+        return IUI_ERR_BAD_STATE;
+    cb->finished = true;
+
+    size_t n = cb->records.size();
+    cb->order.resize(n);
+    for (size_t i = 0; i < n; ++i)
+        cb->order[i] = (uint32_t)i;
+    std::stable_sort(cb->order.begin(), cb->order.end(),
+                     [cb](uint32_t a, uint32_t b) {
+                         return cb->records[a].key < cb->records[b].key;
+                     });
+
+    // Size the shared buffers, then tessellate state-contiguous runs in
+    // bulk so plain-quad runs hit the SIMD path.
+    uint32_t total_v = 0, total_i = 0;
+    std::vector<iui_draw_desc> run;
+    for (size_t i = 0; i < n; ++i) {
+        uint32_t v, ix;
+        iui_geometry_measure(&cb->records[cb->order[i]].desc, 1, &v, &ix);
+        total_v += v;
+        total_i += ix;
+    }
+    cb->vertices.resize(total_v);
+    cb->indices.resize(total_i);
+
+    uint32_t v_cursor = 0, i_cursor = 0;
+    size_t i = 0;
+    while (i < n) {
+        uint64_t key = cb->records[cb->order[i]].key;
+        size_t run_end = i;
+        run.clear();
+        while (run_end < n && cb->records[cb->order[run_end]].key == key)
+            run.push_back(cb->records[cb->order[run_end++]].desc);
+
+        uint32_t v_count = 0, i_count = 0;
+        iui_geometry_emit(run.data(), (uint32_t)run.size(),
+                          cb->vertices.data() + v_cursor,
+                          cb->indices.data() + i_cursor, v_cursor, &v_count,
+                          &i_count);
+
+        iui_draw_batch batch;
+        batch.texture = (uint32_t)(key & 0xffffffu);
+        uint32_t scissor_id = (uint32_t)((key >> 24) & 0xffffu);
+        batch.scissor_enabled = scissor_id != 0;
+        batch.scissor =
+            scissor_id ? cb->scissors[scissor_id] : iui_rect{};
+        batch.index_offset = i_cursor;
+        batch.index_count = i_count;
+        cb->batches.push_back(batch);
+
+        v_cursor += v_count;
+        i_cursor += i_count;
+        i = run_end;
+    }
+    return IUI_OK;
+}
+
+uint32_t iui_cmd_buffer_batches(const iui_cmd_buffer *cb,
+                                const iui_draw_batch **out) {
+    if (!cb || !cb->finished)
+        return 0;
+    if (out)
+        *out = cb->batches.data();
+    return (uint32_t)cb->batches.size();
+}
+
+const iui_vertex *iui_cmd_buffer_vertices(const iui_cmd_buffer *cb,
+                                          uint32_t *count) {
+    if (!cb || !cb->finished) {
+        if (count)
+            *count = 0;
+        return nullptr;
+    }
+    if (count)
+        *count = (uint32_t)cb->vertices.size();
+    return cb->vertices.data();
+}
+
+const uint32_t *iui_cmd_buffer_indices(const iui_cmd_buffer *cb,
+                                       uint32_t *count) {
+    if (!cb || !cb->finished) {
+        if (count)
+            *count = 0;
+        return nullptr;
+    }
+    if (count)
+        *count = (uint32_t)cb->indices.size();
+    return cb->indices.data();
+}
+
+} // extern "C"
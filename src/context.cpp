@@ -0,0 +1,202 @@
+// context.cpp — context lifetime and the frame/widget declaration API.
+
+#include "context.h"
+
+#include "iui/intern.h"
+#include "iui/startup.h"
+#include "iui/theme.h"
+
+#include "intern.h"
+#include "task_pool.h"
+
+#include <atomic>
+#include <new>
+
+namespace iui {
+
+uint64_t hash_id(const char *id) {
+    uint64_t h = 1469598103934665603ull;
+    for (const unsigned char *p = (const unsigned char *)id; *p; ++p) {
+        h ^= *p;
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+} // namespace iui
+
+extern "C" {
+
+iui_context *iui_context_create(void) {
+    iui_context *ctx = new (std::nothrow) iui_context();
+    if (!ctx)
+        return nullptr;
+    ctx->nodes.reserve(1024);
+    ctx->theme = iui_theme_default();
+    iui_startup_mark("core.context_create");
+    return ctx;
+}
+
+void iui_context_destroy(iui_context *ctx) {
+    if (!ctx)
+        return;
+    iui::release_channels(*ctx);
+    delete ctx;
+}
+
+void iui_set_worker_threads(uint32_t count) {
+    iui::task_pool::set_requested_threads(count);
+}
+
+iui_status iui_frame_begin(iui_context *ctx, float width, float height) {
+    if (!ctx || width < 0.0f || height < 0.0f)
+        return IUI_ERR_INVALID_ARG;
+    iui::profile_frame_begin(*ctx);
+    iui::input_frame_begin(*ctx);
+    // Advance timelines before declarations so animated scroll offsets
+    // are in the store when layout consumes them.
+    iui::anim_advance(*ctx);
+    ctx->frame_arena.reset();
+    ctx->nodes.clear();
+    ctx->nodes.emplace_back(); // index 0: sentinel
+    iui::node root;
+    root.want_w = width;
+    root.want_h = height;
+    root.path_hash = iui::hash_id("iui.root");
+    ctx->store.begin_frame();
+    root.slot = ctx->store.acquire(root.path_hash);
+    ctx->nodes.push_back(root); // index 1: root
+    ctx->current_parent = 1;
+    ctx->frame_w = width;
+    ctx->frame_h = height;
+    ctx->in_frame = true;
+    return IUI_OK;
+}
+
+iui_status iui_frame_end(iui_context *ctx) {
+    if (!ctx || !ctx->in_frame)
+        return IUI_ERR_BAD_STATE;
+    if (ctx->current_parent != 1)
+        return IUI_ERR_BAD_STATE; // unbalanced widget_begin/end
+    ctx->in_frame = false;
+    uint64_t t0 = iui::now_us();
+    iui::solve_layout(*ctx);
+    // Publish final bounds into the persistent bounds column so systems
+    // that outlive the frame (animation, spatial index, renderers) read
+    // one linear array.
+    for (uint32_t i = 1; i < (uint32_t)ctx->nodes.size(); ++i)
+        ctx->store.bounds[ctx->nodes[i].slot] = ctx->nodes[i].bounds;
+    iui::compute_damage(*ctx);
+    // Geometry moved somewhere, so the point index is stale; frames that
+    // damaged nothing keep it, which is what makes 1000 Hz hover cheap.
+    if (!ctx->damage.empty())
+        ctx->hit_index.valid = false;
+    iui::profile_phase_add(*ctx, IUI_PHASE_LAYOUT, iui::now_us() - t0);
+    // First completed frame in the process ends the cold-start window.
+    static std::atomic<bool> first_frame_marked{false};
+    if (!first_frame_marked.exchange(true))
+        iui_startup_mark("core.first_frame");
+    return IUI_OK;
+}
+
+static iui_widget widget_begin_hashed(iui_context *ctx, uint64_t id_hash) {
+    uint32_t index = (uint32_t)ctx->nodes.size();
+    iui::node n;
+    n.parent = ctx->current_parent;
+    n.id_hash = id_hash;
+    n.path_hash =
+        iui::hash_mix(ctx->nodes[ctx->current_parent].path_hash, n.id_hash);
+    n.slot = ctx->store.acquire(n.path_hash);
+    ctx->nodes.push_back(n);
+
+    iui::node &parent = ctx->nodes[ctx->current_parent];
+    if (parent.last_child)
+        ctx->nodes[parent.last_child].next_sibling = index;
+    else
+        parent.first_child = index;
+    parent.last_child = index;
+
+    ctx->current_parent = index;
+    return index;
+}
+
+iui_widget iui_widget_begin(iui_context *ctx, const char *id) {
+    if (!ctx || !id || !ctx->in_frame)
+        return IUI_INVALID_WIDGET;
+    return widget_begin_hashed(ctx, iui::hash_id(id));
+}
+
+iui_widget iui_widget_begin_h(iui_context *ctx, iui_str id) {
+    iui::intern_ref ref;
+    if (!ctx || !ctx->in_frame || !iui::intern_lookup(id, ref))
+        return IUI_INVALID_WIDGET;
+    return widget_begin_hashed(ctx, ref.hash);
+}
+
+iui_status iui_widget_end(iui_context *ctx) {
+    if (!ctx || !ctx->in_frame || ctx->current_parent <= 1)
+        return IUI_ERR_BAD_STATE;
+    ctx->current_parent = ctx->nodes[ctx->current_parent].parent;
+    return IUI_OK;
+}
+
+static iui::node *current_node(iui_context *ctx) {
+    if (!ctx || !ctx->in_frame || ctx->current_parent <= 1)
+        return nullptr;
+    return &ctx->nodes[ctx->current_parent];
+}
+
+iui_status iui_widget_set_size(iui_context *ctx, float w, float h) {
+    iui::node *n = current_node(ctx);
+    if (!n)
+        return IUI_ERR_BAD_STATE;
+    n->want_w = w;
+    n->want_h = h;
+    return IUI_OK;
+}
+
+iui_status iui_widget_set_axis(iui_context *ctx, iui_axis axis) {
+    iui::node *n = current_node(ctx);
+    if (!n)
+        return IUI_ERR_BAD_STATE;
+    n->axis = axis;
+    return IUI_OK;
+}
+
+iui_status iui_widget_set_padding(iui_context *ctx, float padding) {
+    iui::node *n = current_node(ctx);
+    if (!n)
+        return IUI_ERR_BAD_STATE;
+    n->padding = padding;
+    return IUI_OK;
+}
+
+iui_status iui_widget_set_spacing(iui_context *ctx, float spacing) {
+    iui::node *n = current_node(ctx);
+    if (!n)
+        return IUI_ERR_BAD_STATE;
+    n->spacing = spacing;
+    return IUI_OK;
+}
+
+iui_status iui_widget_bounds(const iui_context *ctx, iui_widget w,
+                             iui_rect *out) {
+    if (!ctx || !out || w == 0 || w >= ctx->nodes.size())
+        return IUI_ERR_INVALID_ARG;
+    *out = ctx->nodes[w].bounds;
+    return IUI_OK;
+}
+
+uint32_t iui_widget_count(const iui_context *ctx) {
+    if (!ctx || ctx->nodes.size() < 2)
+        return 0;
+    return (uint32_t)ctx->nodes.size() - 2; // minus sentinel and root
+}
+
+iui_widget iui_hit_test(const iui_context *ctx, float x, float y) {
+    if (!ctx || ctx->in_frame)
+        return IUI_INVALID_WIDGET;
+    return iui::hit_test(*ctx, x, y);
+}
+
+} // extern "C"
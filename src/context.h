@@ -0,0 +1,235 @@
+// context.h — internal state behind the iui_context handle.
+//
+// Widgets live in a flat vector of nodes rebuilt every frame; links are
+// indices, not pointers, so the whole tree can be walked and relocated
+// without chasing the heap.  Index 0 is a sentinel, index 1 is the root.
+#ifndef IUI_SRC_CONTEXT_H
+#define IUI_SRC_CONTEXT_H
+
+#include "iui/iui.h"
+#include "iui/profiler.h"
+#include "iui/trace.h"
+
+#include "arena.h"
+#include "widget_store.h"
+
+#include <unordered_map>
+#include <vector>
+
+struct iui_buffer;  // buffer.cpp
+struct iui_theme;   // theme.cpp
+struct iui_capture; // capture.cpp
+
+// Ring-addressed persistent pane texture; see include/iui/layer.h.  The
+// resident range is the contiguous span of content rows whose pixels in
+// the ring are current; updates re-render only what the view needs beyond
+// it plus anything invalidated.
+struct iui_scroll_layer {
+    float view_w = 0.0f;
+    float view_h = 0.0f;
+    float layer_h = 0.0f;
+    uint32_t texture = 0;
+    bool valid = false;    // false forces a full re-render next update
+    float res0 = 0.0f;     // resident content range [res0, res1)
+    float res1 = 0.0f;
+    float dirty0 = 0.0f;   // invalidated content range, folded in on update
+    float dirty1 = 0.0f;   // empty when dirty1 <= dirty0
+};
+
+namespace iui {
+
+struct node {
+    uint32_t parent = 0;
+    uint32_t first_child = 0;
+    uint32_t last_child = 0;
+    uint32_t next_sibling = 0;
+    uint64_t id_hash = 0;
+    uint64_t path_hash = 0;    // id hash folded with the ancestor chain
+    uint64_t content_hash = 0; // app-declared visual content
+    uint64_t subtree_hash = 0; // bounds + content + children, bottom-up
+    uint32_t slot = 0;         // persistent store slot for this path
+    bool dirty = false;        // subtree changed since last frame
+    float want_w = IUI_SIZE_FILL;
+    float want_h = IUI_SIZE_FILL;
+    float padding = 0.0f;
+    float spacing = 0.0f;
+    iui_axis axis = IUI_AXIS_COLUMN;
+    iui_rect bounds{};
+};
+
+// FNV-1a; sibling ids are short strings, this is fast and collision-safe
+// enough when combined with the parent chain.
+uint64_t hash_id(const char *id);
+
+// 64-bit mix for combining hashes (splitmix64 finalizer).
+inline uint64_t hash_mix(uint64_t h, uint64_t v) {
+    h ^= v + 0x9e3779b97f4a7c15ull + (h << 6) + (h >> 2);
+    h ^= h >> 30;
+    h *= 0xbf58476d1ce4e5b9ull;
+    h ^= h >> 27;
+    return h;
+}
+
+void solve_layout(struct ::iui_context &ctx);
+uint32_t hit_test(const struct ::iui_context &ctx, float x, float y);
+void compute_damage(struct ::iui_context &ctx);
+
+// Uniform-grid point index over node bounds (hit_test.cpp).  Flat
+// counting-sort layout: cell_start gives each cell's slice of entries,
+// entries hold node indices in ascending (z) order.  Rebuilt lazily on
+// the first query after a frame that produced damage; a hover-only frame
+// reuses it untouched.
+struct hit_grid {
+    static constexpr float kCellSize = 64.0f;
+
+    bool valid = false;
+    uint32_t cols = 0;
+    uint32_t rows = 0;
+    std::vector<uint32_t> cell_start; // cols * rows + 1 prefix sums
+    std::vector<uint32_t> entries;    // node indices
+
+    void build(const struct ::iui_context &ctx);
+};
+
+// Profiler internals (profiler.cpp); the ring is fixed-size so steady-state
+// profiling allocates nothing.
+struct profiler_state {
+    static constexpr uint32_t kRingSize = 256;
+
+    iui_frame_profile ring[kRingSize];
+    uint32_t ring_head = 0;
+    uint32_t ring_count = 0;
+    iui_frame_profile current{};
+    uint64_t phase_start_us[IUI_PHASE_COUNT] = {};
+    uint64_t frame_start_us = 0;
+    uint64_t epoch_us = 0;
+    uint64_t next_frame_index = 0;
+    bool frame_open = false;
+};
+
+// Input queue internals (input.cpp); everything is fixed-size so pushing
+// at device-interrupt rate allocates nothing.
+struct input_state {
+    static constexpr uint32_t kBatchMax = 64;    // IUI_INPUT_BATCH_MAX
+    static constexpr uint32_t kHistorySize = 1024;
+
+    iui_event pending[kBatchMax];  // coalesced, waiting for frame_begin
+    uint32_t pending_count = 0;
+    iui_event batch[kBatchMax];    // published to the UI this frame
+    uint32_t batch_count = 0;
+    uint32_t dropped = 0;          // overflow since last frame_begin
+
+    iui_event history[kHistorySize]; // raw samples, ring
+    uint32_t history_head = 0;
+    uint64_t history_total = 0;
+};
+
+void input_frame_begin(struct ::iui_context &ctx);
+
+// Animation internals (anim.cpp); active timelines as parallel flat
+// arrays so the per-frame advance is one linear pass.
+struct anim_state {
+    std::vector<uint32_t> slot;
+    std::vector<uint32_t> prop;
+    std::vector<float> from;
+    std::vector<float> to;
+    std::vector<uint64_t> start_us;
+    std::vector<uint64_t> end_us;
+    std::vector<uint32_t> curve;
+
+    void swap_remove(uint32_t i) {
+        slot[i] = slot.back();
+        prop[i] = prop.back();
+        from[i] = from.back();
+        to[i] = to.back();
+        start_us[i] = start_us.back();
+        end_us[i] = end_us.back();
+        curve[i] = curve.back();
+        slot.pop_back();
+        prop.pop_back();
+        from.pop_back();
+        to.pop_back();
+        start_us.pop_back();
+        end_us.pop_back();
+        curve.pop_back();
+    }
+};
+
+void anim_advance(struct ::iui_context &ctx);
+
+uint64_t now_us();
+void profile_frame_begin(struct ::iui_context &ctx);
+void profile_phase_add(struct ::iui_context &ctx, iui_phase phase,
+                       uint64_t us);
+void release_channels(struct ::iui_context &ctx);
+
+} // namespace iui
+
+struct iui_context {
+    std::vector<iui::node> nodes;
+    uint32_t current_parent = 0; // parse cursor during frame declaration
+    float frame_w = 0.0f;
+    float frame_h = 0.0f;
+    bool in_frame = false;
+
+    // Damage tracking: previous frame's subtree hash and bounds per widget
+    // path, and the dirty rectangles produced by the last frame_end.
+    struct prev_widget {
+        uint64_t own_hash;
+        uint64_t subtree_hash;
+        iui_rect bounds;
+    };
+    std::unordered_map<uint64_t, prev_widget> prev_frame;
+    std::vector<iui_rect> damage;
+
+    // Incremental layout: cached solved geometry per island, keyed by the
+    // island root's path hash.  An island whose input hash and assigned
+    // rect are unchanged gets its cached bounds copied back (translated by
+    // any origin shift) instead of being re-solved.
+    struct island_cache {
+        uint64_t input_hash = 0;
+        float fit_w = 0.0f, fit_h = 0.0f; // provisional size from fit pass
+        iui_rect placed{};                // rect assigned last frame
+        std::vector<iui_rect> bounds;     // absolute, declaration order
+    };
+    std::unordered_map<uint64_t, island_cache> layout_cache;
+
+    // Per-frame transient allocations; reset wholesale in iui_frame_begin.
+    iui::arena frame_arena;
+
+    iui::profiler_state profiler;
+
+    // Frame-synchronized input queue; see include/iui/input.h.
+    iui::input_state input;
+
+    // Active animation timelines (anim.cpp).
+    iui::anim_state anim;
+
+    // Attached interaction capture, or null (capture.cpp); fed by the
+    // input queue.
+    iui_capture *capture = nullptr;
+
+    // Point-query acceleration; mutable because it is a lazily built
+    // cache behind the const hit-test API.
+    mutable iui::hit_grid hit_index;
+
+    // Cross-frame SoA state; see include/iui/store.h.
+    iui::widget_store store;
+
+    // Active style tables; points at the precompiled default until the
+    // app installs its own (theme.cpp).
+    const iui_theme *theme = nullptr;
+
+    // Persistent scroll layers keyed by widget path (scroll_layer.cpp).
+    std::unordered_map<uint64_t, iui_scroll_layer> scroll_layers;
+
+    // Zero-copy transfer channels (buffer.cpp); one buffer per MIME type.
+    struct mime_entry {
+        uint64_t mime_hash;
+        iui_buffer *buffer;
+    };
+    std::vector<mime_entry> clipboard;
+    std::vector<mime_entry> dnd;
+};
+
+#endif // IUI_SRC_CONTEXT_H
@@ -0,0 +1,171 @@
+// damage.cpp — subtree hashing and dirty-rectangle accumulation.
+//
+// Runs right after layout in iui_frame_end.  One reverse walk folds
+// bounds, content and child hashes into a per-node subtree hash (reverse
+// iteration over the flat array is bottom-up, the same trick the layout
+// fit pass uses).  The diff against the previous frame's path-keyed map
+// then marks changed subtrees dirty and collects their bounds; a subtree
+// whose hash is unchanged is skipped without visiting its children.
+
+#include "context.h"
+
+#include "iui/damage.h"
+
+#include <cmath>
+
+namespace iui {
+
+namespace {
+
+// Damage lists longer than this collapse into their union; past a few
+// dozen rects the per-rect present overhead beats a full redraw anyway.
+constexpr size_t kMaxDamageRects = 64;
+
+uint64_t hash_rect(uint64_t h, const iui_rect &r) {
+    // Quantize to 1/8 px so float noise does not defeat the comparison.
+    h = hash_mix(h, (uint64_t)(int64_t)std::lround(r.x * 8.0f));
+    h = hash_mix(h, (uint64_t)(int64_t)std::lround(r.y * 8.0f));
+    h = hash_mix(h, (uint64_t)(int64_t)std::lround(r.w * 8.0f));
+    h = hash_mix(h, (uint64_t)(int64_t)std::lround(r.h * 8.0f));
+    return h;
+}
+
+// Hash of the node's own visual: identity, declared content, final rect.
+uint64_t own_hash(const node &n) {
+    return hash_rect(hash_mix(n.id_hash, n.content_hash), n.bounds);
+}
+
+bool overlaps(const iui_rect &a, const iui_rect &b) {
+    return a.x < b.x + b.w && b.x < a.x + a.w && a.y < b.y + b.h &&
+           b.y < a.y + a.h;
+}
+
+iui_rect rect_union(const iui_rect &a, const iui_rect &b) {
+    float x0 = a.x < b.x ? a.x : b.x;
+    float y0 = a.y < b.y ? a.y : b.y;
+    float x1 = a.x + a.w > b.x + b.w ? a.x + a.w : b.x + b.w;
+    float y1 = a.y + a.h > b.y + b.h ? a.y + a.h : b.y + b.h;
+    return iui_rect{x0, y0, x1 - x0, y1 - y0};
+}
+
+void add_damage(iui_context &ctx, const iui_rect &r) {
+    if (r.w <= 0.0f || r.h <= 0.0f)
+        return;
+    // Fold into an overlapping rect when possible to keep the list short.
+    for (iui_rect &d : ctx.damage) {
+        if (overlaps(d, r)) {
+            d = rect_union(d, r);
+            return;
+        }
+    }
+    if (ctx.damage.size() >= kMaxDamageRects) {
+        iui_rect all = r;
+        for (const iui_rect &d : ctx.damage)
+            all = rect_union(all, d);
+        ctx.damage.clear();
+        ctx.damage.push_back(all);
+        return;
+    }
+    ctx.damage.push_back(r);
+}
+
+void mark_dirty(iui_context &ctx, uint32_t index) {
+    ctx.nodes[index].dirty = true;
+    for (uint32_t c = ctx.nodes[index].first_child; c;
+         c = ctx.nodes[c].next_sibling)
+        mark_dirty(ctx, c);
+}
+
+// Diff one node against the previous frame.  The parent's rect covers its
+// children, so a fully-changed subtree contributes one damage rect.
+void diff_node(iui_context &ctx, uint32_t index) {
+    node &n = ctx.nodes[index];
+    auto it = ctx.prev_frame.find(n.path_hash);
+    if (it == ctx.prev_frame.end()) {
+        // New widget: everything under it needs a first render.
+        mark_dirty(ctx, index);
+        add_damage(ctx, n.bounds);
+        return;
+    }
+    const iui_context::prev_widget &prev = it->second;
+    if (prev.subtree_hash == n.subtree_hash)
+        return; // unchanged subtree, skip the children entirely
+    if (prev.own_hash != own_hash(n)) {
+        // The node itself moved or changed; repaint old and new extents.
+        mark_dirty(ctx, index);
+        add_damage(ctx, prev.bounds);
+        add_damage(ctx, n.bounds);
+        return;
+    }
+    // Node is visually identical but some descendant changed: refine.
+    n.dirty = true;
+    for (uint32_t c = n.first_child; c; c = ctx.nodes[c].next_sibling)
+        diff_node(ctx, c);
+}
+
+} // namespace
+
+void compute_damage(iui_context &ctx) {
+    auto &nodes = ctx.nodes;
+    ctx.damage.clear();
+    if (nodes.size() < 2)
+        return;
+
+    // Bottom-up subtree hashes.  Children appear after their parent in the
+    // array, so by the time we reach a node its children are final.
+    for (uint32_t i = (uint32_t)nodes.size() - 1; i >= 1; --i) {
+        node &n = nodes[i];
+        uint64_t h = own_hash(n);
+        for (uint32_t c = n.first_child; c; c = nodes[c].next_sibling)
+            h = hash_mix(h, nodes[c].subtree_hash);
+        n.subtree_hash = h;
+        n.dirty = false;
+    }
+
+    diff_node(ctx, 1);
+
+    // Rebuild the map for the next frame, then damage anything that was
+    // present last frame but is gone now.
+    std::unordered_map<uint64_t, iui_context::prev_widget> next;
+    next.reserve(nodes.size());
+    for (uint32_t i = 1; i < (uint32_t)nodes.size(); ++i) {
+        const node &n = nodes[i];
+        next[n.path_hash] =
+            iui_context::prev_widget{own_hash(n), n.subtree_hash, n.bounds};
+    }
+    for (const auto &kv : ctx.prev_frame) {
+        if (next.find(kv.first) == next.end())
+            add_damage(ctx, kv.second.bounds);
+    }
+    ctx.prev_frame.swap(next);
+}
+
+} // namespace iui
+
+extern "C" {
+
+iui_status iui_widget_set_content_hash(iui_context *ctx, uint64_t hash) {
+    if (!ctx || !ctx->in_frame || ctx->current_parent <= 1)
+        return IUI_ERR_BAD_STATE;
+    ctx->nodes[ctx->current_parent].content_hash = hash;
+    return IUI_OK;
+}
+
+uint32_t iui_frame_damage(const iui_context *ctx, iui_rect *out,
+                          uint32_t max) {
+    if (!ctx || ctx->in_frame)
+        return 0;
+    uint32_t count = (uint32_t)ctx->damage.size();
+    uint32_t n = count < max ? count : max;
+    for (uint32_t i = 0; i < n; ++i)
+        out[i] = ctx->damage[i];
+    return count;
+}
+
+int iui_widget_is_dirty(const iui_context *ctx, iui_widget w) {
+    if (!ctx || w == 0 || w >= ctx->nodes.size())
+        return 0;
+    return ctx->nodes[w].dirty ? 1 : 0;
+}
+
+} // extern "C"
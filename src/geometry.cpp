@@ -0,0 +1,235 @@
+// geometry.cpp — batched quad and rounded-rect tessellation.
+//
+// The hot case by far is the plain quad (flat panels, table cells, glyph
+// quads).  The SSE2 path transposes four descriptors at a time, computes
+// all corner positions and UVs vectorized, and writes each vertex's
+// x,y,u,v block with a single 16-byte store.  Rounded rectangles are rare
+// (a few hundred per frame at most) and tessellate scalar as a center
+// quad, four edge quads and four corner fans.
+
+#include "iui/geometry.h"
+
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#define IUI_HAVE_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+constexpr uint32_t kQuadVerts = 4;
+constexpr uint32_t kQuadIndices = 6;
+// Center + 4 edges = 5 quads, plus a fan of IUI_CORNER_SEGMENTS triangles
+// per corner sharing the corner-circle center vertex.
+constexpr uint32_t kRoundVerts =
+    5 * kQuadVerts + 4 * (IUI_CORNER_SEGMENTS + 2);
+constexpr uint32_t kRoundIndices =
+    5 * kQuadIndices + 4 * 3 * IUI_CORNER_SEGMENTS;
+
+inline void write_vertex(iui_vertex *v, float x, float y, float u, float tv,
+                         uint32_t color) {
+    v->x = x;
+    v->y = y;
+    v->u = u;
+    v->v = tv;
+    v->color = color;
+}
+
+inline void write_quad_indices(uint32_t *idx, uint32_t base) {
+    idx[0] = base + 0;
+    idx[1] = base + 1;
+    idx[2] = base + 2;
+    idx[3] = base + 2;
+    idx[4] = base + 3;
+    idx[5] = base + 0;
+}
+
+// Scalar quad: vertices clockwise from top-left.
+void emit_quad(const iui_draw_desc &d, iui_vertex *v, uint32_t *idx,
+               uint32_t base) {
+    float x1 = d.rect.x + d.rect.w;
+    float y1 = d.rect.y + d.rect.h;
+    write_vertex(v + 0, d.rect.x, d.rect.y, d.u0, d.v0, d.color);
+    write_vertex(v + 1, x1, d.rect.y, d.u1, d.v0, d.color);
+    write_vertex(v + 2, x1, y1, d.u1, d.v1, d.color);
+    write_vertex(v + 3, d.rect.x, y1, d.u0, d.v1, d.color);
+    write_quad_indices(idx, base);
+}
+
+void emit_subquad(float x0, float y0, float x1, float y1, uint32_t color,
+                  float u, float v, iui_vertex *verts, uint32_t *idx,
+                  uint32_t base) {
+    write_vertex(verts + 0, x0, y0, u, v, color);
+    write_vertex(verts + 1, x1, y0, u, v, color);
+    write_vertex(verts + 2, x1, y1, u, v, color);
+    write_vertex(verts + 3, x0, y1, u, v, color);
+    write_quad_indices(idx, base);
+}
+
+// Rounded rect: untextured fill (rounded widgets sample a flat color; the
+// midpoint UV keeps them inside the same atlas batch as everything else).
+void emit_rounded(const iui_draw_desc &d, iui_vertex *v, uint32_t *idx,
+                  uint32_t base) {
+    float max_r = (d.rect.w < d.rect.h ? d.rect.w : d.rect.h) * 0.5f;
+    float r = d.corner_radius < max_r ? d.corner_radius : max_r;
+    float x0 = d.rect.x, y0 = d.rect.y;
+    float x1 = d.rect.x + d.rect.w, y1 = d.rect.y + d.rect.h;
+    float u = (d.u0 + d.u1) * 0.5f, tv = (d.v0 + d.v1) * 0.5f;
+
+    iui_vertex *p = v;
+    uint32_t *ix = idx;
+    uint32_t b = base;
+    // Center and the four edge strips.
+    emit_subquad(x0 + r, y0 + r, x1 - r, y1 - r, d.color, u, tv, p, ix, b);
+    p += 4, ix += 6, b += 4;
+    emit_subquad(x0 + r, y0, x1 - r, y0 + r, d.color, u, tv, p, ix, b);
+    p += 4, ix += 6, b += 4;
+    emit_subquad(x0 + r, y1 - r, x1 - r, y1, d.color, u, tv, p, ix, b);
+    p += 4, ix += 6, b += 4;
+    emit_subquad(x0, y0 + r, x0 + r, y1 - r, d.color, u, tv, p, ix, b);
+    p += 4, ix += 6, b += 4;
+    emit_subquad(x1 - r, y0 + r, x1, y1 - r, d.color, u, tv, p, ix, b);
+    p += 4, ix += 6, b += 4;
+
+    // Corner fans: center vertex plus SEGMENTS+1 arc vertices each.
+    const float centers[4][2] = {{x0 + r, y0 + r},
+                                 {x1 - r, y0 + r},
+                                 {x1 - r, y1 - r},
+                                 {x0 + r, y1 - r}};
+    const float start_angle[4] = {3.14159265f, 4.71238898f, 0.0f,
+                                  1.57079633f};
+    for (int corner = 0; corner < 4; ++corner) {
+        uint32_t fan_base = b;
+        write_vertex(p++, centers[corner][0], centers[corner][1], u, tv,
+                     d.color);
+        for (int s = 0; s <= IUI_CORNER_SEGMENTS; ++s) {
+            float a = start_angle[corner] +
+                      1.57079633f * (float)s / (float)IUI_CORNER_SEGMENTS;
+            write_vertex(p++, centers[corner][0] + r * std::cos(a),
+                         centers[corner][1] + r * std::sin(a), u, tv,
+                         d.color);
+        }
+        for (int s = 0; s < IUI_CORNER_SEGMENTS; ++s) {
+            ix[0] = fan_base;
+            ix[1] = fan_base + 1 + (uint32_t)s;
+            ix[2] = fan_base + 2 + (uint32_t)s;
+            ix += 3;
+        }
+        b += IUI_CORNER_SEGMENTS + 2;
+    }
+}
+
+#ifdef IUI_HAVE_SSE2
+// Four plain quads at once.  Descriptor rects and UVs are transposed into
+// component vectors; the final interleaved store is one _mm_storeu_ps of
+// the x,y,u,v block per vertex plus the scalar color word.
+void emit_quads_x4(const iui_draw_desc *d, iui_vertex *v, uint32_t *idx,
+                   uint32_t base) {
+    __m128 r0 = _mm_loadu_ps(&d[0].rect.x); // x y w h
+    __m128 r1 = _mm_loadu_ps(&d[1].rect.x);
+    __m128 r2 = _mm_loadu_ps(&d[2].rect.x);
+    __m128 r3 = _mm_loadu_ps(&d[3].rect.x);
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3); // r0=x r1=y r2=w r3=h
+    __m128 xmax = _mm_add_ps(r0, r2);
+    __m128 ymax = _mm_add_ps(r1, r3);
+
+    __m128 t0 = _mm_loadu_ps(&d[0].u0); // u0 v0 u1 v1
+    __m128 t1 = _mm_loadu_ps(&d[1].u0);
+    __m128 t2 = _mm_loadu_ps(&d[2].u0);
+    __m128 t3 = _mm_loadu_ps(&d[3].u0);
+    _MM_TRANSPOSE4_PS(t0, t1, t2, t3); // t0=u0 t1=v0 t2=u1 t3=v1
+
+    alignas(16) float xs0[4], ys0[4], xs1[4], ys1[4];
+    alignas(16) float us0[4], vs0[4], us1[4], vs1[4];
+    _mm_store_ps(xs0, r0);
+    _mm_store_ps(ys0, r1);
+    _mm_store_ps(xs1, xmax);
+    _mm_store_ps(ys1, ymax);
+    _mm_store_ps(us0, t0);
+    _mm_store_ps(vs0, t1);
+    _mm_store_ps(us1, t2);
+    _mm_store_ps(vs1, t3);
+
+    for (int i = 0; i < 4; ++i) {
+        uint32_t color = d[i].color;
+        iui_vertex *q = v + i * 4;
+        _mm_storeu_ps(&q[0].x, _mm_setr_ps(xs0[i], ys0[i], us0[i], vs0[i]));
+        q[0].color = color;
+        _mm_storeu_ps(&q[1].x, _mm_setr_ps(xs1[i], ys0[i], us1[i], vs0[i]));
+        q[1].color = color;
+        _mm_storeu_ps(&q[2].x, _mm_setr_ps(xs1[i], ys1[i], us1[i], vs1[i]));
+        q[2].color = color;
+        _mm_storeu_ps(&q[3].x, _mm_setr_ps(xs0[i], ys1[i], us0[i], vs1[i]));
+        q[3].color = color;
+        write_quad_indices(idx + i * 6, base + (uint32_t)i * 4);
+    }
+}
+#endif
+
+} // namespace
+
+extern "C" {
+
+void iui_geometry_measure(const iui_draw_desc *descs, uint32_t count,
+                          uint32_t *vertex_count_out,
+                          uint32_t *index_count_out) {
+    uint32_t verts = 0, indices = 0;
+    for (uint32_t i = 0; i < count; ++i) {
+        if (descs[i].corner_radius > 0.0f) {
+            verts += kRoundVerts;
+            indices += kRoundIndices;
+        } else {
+            verts += kQuadVerts;
+            indices += kQuadIndices;
+        }
+    }
+    if (vertex_count_out)
+        *vertex_count_out = verts;
+    if (index_count_out)
+        *index_count_out = indices;
+}
+
+iui_status iui_geometry_emit(const iui_draw_desc *descs, uint32_t count,
+                             iui_vertex *vertices, uint32_t *indices,
+                             uint32_t base_vertex, uint32_t *vertex_count_out,
+                             uint32_t *index_count_out) {
+    if ((!descs || !vertices || !indices) && count)
+        return IUI_ERR_INVALID_ARG;
+    uint32_t v = 0, ix = 0;
+    uint32_t i = 0;
+    while (i < count) {
+#ifdef IUI_HAVE_SSE2
+        // Runs of plain quads take the 4-wide path.
+        if (i + 4 <= count && descs[i].corner_radius <= 0.0f &&
+            descs[i + 1].corner_radius <= 0.0f &&
+            descs[i + 2].corner_radius <= 0.0f &&
+            descs[i + 3].corner_radius <= 0.0f) {
+            emit_quads_x4(descs + i, vertices + v, indices + ix,
+                          base_vertex + v);
+            v += 4 * kQuadVerts;
+            ix += 4 * kQuadIndices;
+            i += 4;
+            continue;
+        }
+#endif
+        if (descs[i].corner_radius > 0.0f) {
+            emit_rounded(descs[i], vertices + v, indices + ix,
+                         base_vertex + v);
+            v += kRoundVerts;
+            ix += kRoundIndices;
+        } else {
+            emit_quad(descs[i], vertices + v, indices + ix, base_vertex + v);
+            v += kQuadVerts;
+            ix += kQuadIndices;
+        }
+        ++i;
+    }
+    if (vertex_count_out)
+        *vertex_count_out = v;
+    if (index_count_out)
+        *index_count_out = ix;
+    return IUI_OK;
+}
+
+} // extern "C"
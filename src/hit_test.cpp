@@ -0,0 +1,106 @@
+// hit_test.cpp — point query over the laid-out tree.
+//
+// Semantics: descend from the root, preferring the later-declared
+// (topmost) child at each level, and return the deepest widget
+// containing the point.  Because the tree is stored in DFS preorder, a
+// later sibling's whole subtree has higher indices than an earlier
+// sibling's, so the same answer is "the highest-index node whose entire
+// ancestor chain contains the point" — which a flat grid can find
+// without walking the tree.
+//
+// The grid buckets node indices by 64 px cells in one counting-sort
+// pass and is rebuilt lazily: frame_end invalidates it only when the
+// frame produced damage, so hover-only frames at 1000 Hz reuse the same
+// index, and each query touches one cell's slice in descending z order.
+
+#include "context.h"
+
+namespace iui {
+
+namespace {
+
+bool contains(const iui_rect &r, float x, float y) {
+    return x >= r.x && y >= r.y && x < r.x + r.w && y < r.y + r.h;
+}
+
+} // namespace
+
+void hit_grid::build(const iui_context &ctx) {
+    const auto &nodes = ctx.nodes;
+    cols = (uint32_t)(ctx.frame_w / kCellSize) + 1;
+    rows = (uint32_t)(ctx.frame_h / kCellSize) + 1;
+    cell_start.assign((size_t)cols * rows + 1, 0);
+    entries.clear();
+
+    auto cell_range = [&](const iui_rect &r, uint32_t &x0, uint32_t &y0,
+                          uint32_t &x1, uint32_t &y1) {
+        auto clamp = [](float v, uint32_t hi) {
+            if (v < 0.0f)
+                return 0u;
+            uint32_t c = (uint32_t)(v / kCellSize);
+            return c >= hi ? hi - 1 : c;
+        };
+        x0 = clamp(r.x, cols);
+        y0 = clamp(r.y, rows);
+        x1 = clamp(r.x + r.w, cols);
+        y1 = clamp(r.y + r.h, rows);
+    };
+
+    // Counting sort: size each cell, prefix-sum, then fill.  Filling in
+    // ascending node order leaves every cell slice z-sorted for free.
+    uint32_t x0, y0, x1, y1;
+    for (uint32_t i = 1; i < nodes.size(); ++i) {
+        if (nodes[i].bounds.w <= 0.0f || nodes[i].bounds.h <= 0.0f)
+            continue;
+        cell_range(nodes[i].bounds, x0, y0, x1, y1);
+        for (uint32_t cy = y0; cy <= y1; ++cy)
+            for (uint32_t cx = x0; cx <= x1; ++cx)
+                ++cell_start[(size_t)cy * cols + cx + 1];
+    }
+    for (size_t c = 1; c < cell_start.size(); ++c)
+        cell_start[c] += cell_start[c - 1];
+    entries.resize(cell_start.back());
+    std::vector<uint32_t> fill(cell_start.begin(), cell_start.end() - 1);
+    for (uint32_t i = 1; i < nodes.size(); ++i) {
+        if (nodes[i].bounds.w <= 0.0f || nodes[i].bounds.h <= 0.0f)
+            continue;
+        cell_range(nodes[i].bounds, x0, y0, x1, y1);
+        for (uint32_t cy = y0; cy <= y1; ++cy)
+            for (uint32_t cx = x0; cx <= x1; ++cx)
+                entries[fill[(size_t)cy * cols + cx]++] = i;
+    }
+    valid = true;
+}
+
+uint32_t hit_test(const iui_context &ctx, float x, float y) {
+    const auto &nodes = ctx.nodes;
+    if (nodes.size() < 2 || !contains(nodes[1].bounds, x, y))
+        return IUI_INVALID_WIDGET;
+
+    hit_grid &grid = ctx.hit_index;
+    if (!grid.valid)
+        grid.build(ctx);
+
+    uint32_t cx = (uint32_t)(x / hit_grid::kCellSize);
+    uint32_t cy = (uint32_t)(y / hit_grid::kCellSize);
+    if (cx >= grid.cols || cy >= grid.rows)
+        return IUI_INVALID_WIDGET;
+    size_t cell = (size_t)cy * grid.cols + cx;
+
+    // Highest index wins, so scan the slice back to front; the ancestor
+    // walk rejects nodes whose chain leaves the point (scrolled-out
+    // overflow), matching the tree descent exactly.
+    for (uint32_t e = grid.cell_start[cell + 1]; e-- > grid.cell_start[cell];) {
+        uint32_t i = grid.entries[e];
+        if (!contains(nodes[i].bounds, x, y))
+            continue;
+        uint32_t p = nodes[i].parent;
+        while (p && contains(nodes[p].bounds, x, y))
+            p = nodes[p].parent;
+        if (p == 0 && i != 1)
+            return i;
+    }
+    return IUI_INVALID_WIDGET;
+}
+
+} // namespace iui
@@ -0,0 +1,219 @@
+// image_pipeline.cpp — worker threads, priority queue and lock-free
+// publication for async image decode.
+//
+// The queue holds (priority, job) pairs under a mutex shared only by
+// workers and the request path; the frame thread never touches it.
+// Results are published by storing width/height/pixels first and the job
+// state last with release ordering, so iui_image_poll is a plain acquire
+// load.  Stale priorities are handled lazily: set_priority re-pushes the
+// job, and workers skip queue entries whose job already left QUEUED.
+
+#include "iui/image.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct job {
+    const void *data;
+    size_t size;
+    std::atomic<int> state{IUI_IMAGE_QUEUED};
+    std::atomic<float> priority;
+    uint32_t width = 0, height = 0;
+    uint8_t *rgba = nullptr;
+};
+
+struct queue_entry {
+    float priority;
+    uint32_t index;
+    bool operator<(const queue_entry &o) const {
+        return priority > o.priority; // min-heap on priority
+    }
+};
+
+constexpr uint32_t kRawMagic = 0x57415249u; /* "IRAW" */
+
+int builtin_raw_decoder(void *, const void *data, size_t size,
+                        uint8_t **rgba_out, uint32_t *width_out,
+                        uint32_t *height_out) {
+    if (size < 12)
+        return 0;
+    const uint32_t *h = (const uint32_t *)data;
+    if (h[0] != kRawMagic)
+        return 0;
+    uint32_t w = h[1], ht = h[2];
+    size_t need = 12 + (size_t)w * ht * 4;
+    if (!w || !ht || size < need)
+        return 0;
+    uint8_t *pixels = (uint8_t *)malloc((size_t)w * ht * 4);
+    if (!pixels)
+        return 0;
+    memcpy(pixels, (const uint8_t *)data + 12, (size_t)w * ht * 4);
+    *rgba_out = pixels;
+    *width_out = w;
+    *height_out = ht;
+    return 1;
+}
+
+} // namespace
+
+struct iui_image_pipeline {
+    iui_image_decoder decoder;
+    void *user;
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::priority_queue<queue_entry> queue;
+    std::vector<job *> jobs; // index = iui_image handle
+    std::vector<std::thread> workers;
+    bool stop = false;
+
+    void worker_loop();
+};
+
+void iui_image_pipeline::worker_loop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+        cv.wait(lock, [this] { return stop || !queue.empty(); });
+        if (stop)
+            return;
+        queue_entry e = queue.top();
+        queue.pop();
+        job *j = jobs[e.index];
+        // Skip stale entries: re-prioritized duplicates or cancelled jobs.
+        int expected = IUI_IMAGE_QUEUED;
+        if (e.priority !=
+                j->priority.load(std::memory_order_relaxed) ||
+            !j->state.compare_exchange_strong(expected, IUI_IMAGE_DECODING,
+                                              std::memory_order_acq_rel))
+            continue;
+        lock.unlock();
+
+        uint8_t *rgba = nullptr;
+        uint32_t w = 0, h = 0;
+        int ok = decoder(user, j->data, j->size, &rgba, &w, &h);
+        if (ok) {
+            j->rgba = rgba;
+            j->width = w;
+            j->height = h;
+            j->state.store(IUI_IMAGE_READY, std::memory_order_release);
+        } else {
+            j->state.store(IUI_IMAGE_FAILED, std::memory_order_release);
+        }
+        lock.lock();
+    }
+}
+
+extern "C" {
+
+iui_image_pipeline *iui_image_pipeline_create(uint32_t worker_count,
+                                              iui_image_decoder decoder,
+                                              void *user) {
+    iui_image_pipeline *p = new (std::nothrow) iui_image_pipeline();
+    if (!p)
+        return nullptr;
+    p->decoder = decoder ? decoder : builtin_raw_decoder;
+    p->user = user;
+    if (worker_count == 0) {
+        unsigned hw = std::thread::hardware_concurrency();
+        worker_count = hw > 4 ? 2 : 1; // decode rarely needs more
+    }
+    for (uint32_t i = 0; i < worker_count; ++i)
+        p->workers.emplace_back([p] { p->worker_loop(); });
+    return p;
+}
+
+void iui_image_pipeline_destroy(iui_image_pipeline *p) {
+    if (!p)
+        return;
+    {
+        std::lock_guard<std::mutex> lock(p->mutex);
+        p->stop = true;
+    }
+    p->cv.notify_all();
+    for (std::thread &t : p->workers)
+        t.join();
+    for (job *j : p->jobs) {
+        free(j->rgba);
+        delete j;
+    }
+    delete p;
+}
+
+iui_image iui_image_request(iui_image_pipeline *p, const void *data,
+                            size_t size, float priority) {
+    if (!p || !data || !size)
+        return IUI_INVALID_IMAGE;
+    job *j = new (std::nothrow) job();
+    if (!j)
+        return IUI_INVALID_IMAGE;
+    j->data = data;
+    j->size = size;
+    j->priority.store(priority, std::memory_order_relaxed);
+    uint32_t index;
+    {
+        std::lock_guard<std::mutex> lock(p->mutex);
+        index = (uint32_t)p->jobs.size();
+        p->jobs.push_back(j);
+        p->queue.push(queue_entry{priority, index});
+    }
+    p->cv.notify_one();
+    return index;
+}
+
+void iui_image_set_priority(iui_image_pipeline *p, iui_image img,
+                            float priority) {
+    if (!p)
+        return;
+    std::lock_guard<std::mutex> lock(p->mutex);
+    if (img >= p->jobs.size())
+        return;
+    job *j = p->jobs[img];
+    if (j->state.load(std::memory_order_relaxed) != IUI_IMAGE_QUEUED)
+        return;
+    j->priority.store(priority, std::memory_order_relaxed);
+    p->queue.push(queue_entry{priority, img}); // old entry goes stale
+    p->cv.notify_one();
+}
+
+iui_image_state iui_image_poll(const iui_image_pipeline *p, iui_image img,
+                               iui_image_result *out) {
+    if (!p || img >= p->jobs.size())
+        return IUI_IMAGE_FAILED;
+    const job *j = p->jobs[img];
+    int state = j->state.load(std::memory_order_acquire);
+    if (state == IUI_IMAGE_READY && out) {
+        out->width = j->width;
+        out->height = j->height;
+        out->rgba = j->rgba;
+    }
+    return (iui_image_state)state;
+}
+
+void iui_image_free(iui_image_pipeline *p, iui_image img) {
+    if (!p)
+        return;
+    std::lock_guard<std::mutex> lock(p->mutex);
+    if (img >= p->jobs.size())
+        return;
+    job *j = p->jobs[img];
+    int state = j->state.load(std::memory_order_acquire);
+    if (state == IUI_IMAGE_READY || state == IUI_IMAGE_FAILED) {
+        free(j->rgba);
+        j->rgba = nullptr;
+        j->state.store(IUI_IMAGE_FAILED, std::memory_order_release);
+    } else {
+        // Still queued: flag it failed so workers skip it.
+        j->state.store(IUI_IMAGE_FAILED, std::memory_order_release);
+    }
+}
+
+} // extern "C"
@@ -0,0 +1,136 @@
+// input.cpp — event coalescing and the frame-synchronized input queue.
+//
+// Pushes land in two places: the raw history ring (verbatim, for gesture
+// recognition) and the pending batch, where runs of compatible events are
+// folded into one record.  Moves keep the latest position and accumulate
+// deltas; scroll ticks accumulate deltas at the latest position.  A fold
+// is only allowed against the most recent pending event from the same
+// device, so ordering relative to clicks and key presses is preserved.
+// iui_frame_begin swaps pending into the published batch, so the UI sees
+// one stable, bounded set of events per frame.
+
+#include "iui/input.h"
+
+#include "iui/capture.h"
+
+#include "context.h"
+
+namespace {
+
+bool coalescable(uint32_t type) {
+    return type == IUI_EVENT_MOUSE_MOVE || type == IUI_EVENT_TOUCH_MOVE ||
+           type == IUI_EVENT_SCROLL;
+}
+
+void fold(iui_event &into, const iui_event &e) {
+    into.dx += e.dx;
+    into.dy += e.dy;
+    into.x = e.x;
+    into.y = e.y;
+    into.time_us = e.time_us;
+}
+
+} // namespace
+
+namespace iui {
+
+void input_frame_begin(iui_context &ctx) {
+    if (ctx.capture)
+        iui_capture_frame_mark(ctx.capture);
+    input_state &in = ctx.input;
+    for (uint32_t i = 0; i < in.pending_count; ++i)
+        in.batch[i] = in.pending[i];
+    in.batch_count = in.pending_count;
+    in.pending_count = 0;
+    in.dropped = 0;
+}
+
+} // namespace iui
+
+extern "C" {
+
+void iui_input_push(iui_context *ctx, const iui_event *e) {
+    if (!ctx || !e)
+        return;
+    iui::input_state &in = ctx->input;
+
+    iui_event ev = *e;
+    if (ev.time_us == 0)
+        ev.time_us = iui::now_us();
+
+    if (ctx->capture)
+        iui_capture_record(ctx->capture, &ev); // raw, pre-coalescing
+
+    in.history[in.history_head] = ev;
+    in.history_head = (in.history_head + 1) % iui::input_state::kHistorySize;
+    ++in.history_total;
+
+    // Fold into the newest pending event when types and device match;
+    // folding across an intervening event of another kind would reorder
+    // the stream as the UI sees it.
+    if (coalescable(ev.type) && in.pending_count > 0) {
+        iui_event &last = in.pending[in.pending_count - 1];
+        if (last.type == ev.type && last.device == ev.device) {
+            fold(last, ev);
+            return;
+        }
+    }
+    if (in.pending_count < iui::input_state::kBatchMax) {
+        in.pending[in.pending_count++] = ev;
+        return;
+    }
+    // Batch full: moves and scrolls still fold into any matching pending
+    // record rather than being lost outright.
+    if (coalescable(ev.type)) {
+        for (uint32_t i = in.pending_count; i-- > 0;) {
+            if (in.pending[i].type == ev.type &&
+                in.pending[i].device == ev.device) {
+                fold(in.pending[i], ev);
+                return;
+            }
+        }
+    }
+    ++in.dropped;
+}
+
+const iui_event *iui_input_events(const iui_context *ctx,
+                                  uint32_t *count_out) {
+    if (!ctx) {
+        if (count_out)
+            *count_out = 0;
+        return nullptr;
+    }
+    if (count_out)
+        *count_out = ctx->input.batch_count;
+    return ctx->input.batch_count ? ctx->input.batch : nullptr;
+}
+
+uint32_t iui_input_dropped(const iui_context *ctx) {
+    return ctx ? ctx->input.dropped : 0;
+}
+
+const iui_event *iui_input_history(const iui_context *ctx, uint32_t age) {
+    if (!ctx)
+        return nullptr;
+    const iui::input_state &in = ctx->input;
+    uint64_t kept = in.history_total < iui::input_state::kHistorySize
+                        ? in.history_total
+                        : iui::input_state::kHistorySize;
+    if (age >= kept)
+        return nullptr;
+    uint32_t idx = (in.history_head + iui::input_state::kHistorySize - 1 -
+                    age) %
+                   iui::input_state::kHistorySize;
+    return &in.history[idx];
+}
+
+uint32_t iui_input_history_count(const iui_context *ctx) {
+    if (!ctx)
+        return 0;
+    uint64_t kept = ctx->input.history_total;
+    if (kept > iui::input_state::kHistorySize)
+        kept = iui::input_state::kHistorySize;
+    return (uint32_t)kept;
+}
+
+} // extern "C"
@@ -0,0 +1,166 @@
+// intern.cpp — the process-wide string intern table.
+//
+// Two structures: an append-only entry store and an open-addressed index
+// from hash to handle.  The index is the occupancy-aware part — it
+// rehashes at 70% load so probe chains stay short as apps accumulate
+// labels.  Interning takes the table mutex; resolving a handle back to
+// bytes is lock-free, which the storage layout has to support: entries
+// live in fixed-size chunks that are allocated once and never moved, and
+// the chunk-pointer table is a fixed array of atomics, so a reader never
+// touches anything a concurrent push can reallocate.  (A deque would keep
+// entry addresses stable but not its internal chunk map — operator[]
+// walks that map, and growth reallocates it under the reader.)
+
+#include "iui/intern.h"
+
+#include "intern.h"
+
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct entry {
+    std::string text;
+    uint64_t hash;
+};
+
+struct intern_table {
+    static constexpr uint32_t kChunkShift = 8;
+    static constexpr uint32_t kChunkSize = 1u << kChunkShift;
+    static constexpr uint32_t kMaxChunks = 4096; // 1M strings
+
+    struct chunk {
+        entry slots[kChunkSize];
+    };
+
+    std::mutex mutex;
+    std::atomic<chunk *> chunks[kMaxChunks] = {};
+    std::atomic<uint32_t> count{0};
+
+    // Open addressing, power-of-two capacity; slot 0 in a bucket means
+    // empty (handles start at 1).
+    std::vector<uint32_t> index;
+
+    static intern_table &instance() {
+        static intern_table t;
+        return t;
+    }
+
+    // Entry for a published handle.  The caller has acquire-loaded count,
+    // which synchronizes with the release store made after the chunk and
+    // the entry were written, so both loads here can be relaxed.
+    const entry &at(uint32_t handle) const {
+        uint32_t i = handle - 1;
+        chunk *c = chunks[i >> kChunkShift].load(std::memory_order_relaxed);
+        return c->slots[i & (kChunkSize - 1)];
+    }
+
+    void rehash(size_t capacity) {
+        std::vector<uint32_t> next(capacity, 0);
+        uint32_t n = count.load(std::memory_order_relaxed);
+        for (uint32_t h = 1; h <= n; ++h) {
+            size_t slot = at(h).hash & (capacity - 1);
+            while (next[slot])
+                slot = (slot + 1) & (capacity - 1);
+            next[slot] = h;
+        }
+        index.swap(next);
+    }
+};
+
+uint64_t fnv1a(const char *s, size_t len) {
+    uint64_t h = 1469598103934665603ull;
+    for (size_t i = 0; i < len; ++i) {
+        h ^= (uint8_t)s[i];
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+} // namespace
+
+namespace iui {
+
+bool intern_lookup(uint32_t handle, intern_ref &out) {
+    intern_table &t = intern_table::instance();
+    if (handle == 0 || handle > t.count.load(std::memory_order_acquire))
+        return false;
+    const entry &e = t.at(handle);
+    out.text = e.text.c_str();
+    out.len = e.text.size();
+    out.hash = e.hash;
+    return true;
+}
+
+} // namespace iui
+
+extern "C" {
+
+iui_str iui_intern(const char *s, size_t len) {
+    if (!s)
+        return IUI_INVALID_STR;
+    if (len == 0)
+        len = strlen(s);
+    uint64_t hash = fnv1a(s, len);
+
+    intern_table &t = intern_table::instance();
+    std::lock_guard<std::mutex> lock(t.mutex);
+    if (t.index.empty())
+        t.rehash(256);
+    size_t mask = t.index.size() - 1;
+    size_t slot = hash & mask;
+    while (t.index[slot]) {
+        const entry &e = t.at(t.index[slot]);
+        if (e.hash == hash && e.text.size() == len &&
+            memcmp(e.text.data(), s, len) == 0)
+            return t.index[slot];
+        slot = (slot + 1) & mask;
+    }
+    uint32_t handle = t.count.load(std::memory_order_relaxed) + 1;
+    if (handle > intern_table::kChunkSize * intern_table::kMaxChunks)
+        return IUI_INVALID_STR; // table full
+    uint32_t ci = (handle - 1) >> intern_table::kChunkShift;
+    intern_table::chunk *c = t.chunks[ci].load(std::memory_order_relaxed);
+    if (!c) {
+        c = new (std::nothrow) intern_table::chunk();
+        if (!c)
+            return IUI_INVALID_STR;
+        t.chunks[ci].store(c, std::memory_order_release);
+    }
+    entry &e = c->slots[(handle - 1) & (intern_table::kChunkSize - 1)];
+    e.text.assign(s, len);
+    e.hash = hash;
+    t.index[slot] = handle;
+    t.count.store(handle, std::memory_order_release);
+    if ((size_t)handle * 10 > t.index.size() * 7) // 70% occupancy
+        t.rehash(t.index.size() * 2);
+    return handle;
+}
+
+const char *iui_str_text(iui_str s, size_t *len_out) {
+    iui::intern_ref ref;
+    if (!iui::intern_lookup(s, ref)) {
+        if (len_out)
+            *len_out = 0;
+        return nullptr;
+    }
+    if (len_out)
+        *len_out = ref.len;
+    return ref.text;
+}
+
+uint64_t iui_str_hash(iui_str s) {
+    iui::intern_ref ref;
+    return iui::intern_lookup(s, ref) ? ref.hash : 0;
+}
+
+uint32_t iui_intern_count(void) {
+    return intern_table::instance().count.load(std::memory_order_acquire);
+}
+
+} // extern "C"
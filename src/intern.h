@@ -0,0 +1,25 @@
+// intern.h — internal view of the process-wide intern table.
+//
+// Modules that accept iui_str handles (widget declaration, text shaping)
+// resolve them through here; the returned pointers are stable for the
+// process lifetime.
+#ifndef IUI_SRC_INTERN_H
+#define IUI_SRC_INTERN_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace iui {
+
+struct intern_ref {
+    const char *text;
+    size_t len;
+    uint64_t hash; // FNV-1a over the bytes, same as hash_id for C strings
+};
+
+// False for IUI_INVALID_STR or an out-of-range handle.
+bool intern_lookup(uint32_t handle, intern_ref &out);
+
+} // namespace iui
+
+#endif // IUI_SRC_INTERN_H
@@ -0,0 +1,287 @@
+// layout.cpp — stacking layout, solved in parallel over subtree islands.
+//
+// Two passes over the flat node array: a bottom-up pass resolves FIT sizes
+// from children, then a top-down pass positions children inside their
+// parent, splitting leftover space on the stacking axis among FILL
+// children.  Declaration order is DFS preorder, so every subtree is a
+// contiguous index range: forward iteration over a range is top-down,
+// reverse is bottom-up — no recursion, no per-node allocation.
+//
+// The root's direct children are independent constraint islands (a panel's
+// layout depends only on the rect the root pass hands it), so on wide
+// scenes each island's fit and place passes run as one task on the shared
+// work pool; small trees stay on the calling thread to avoid dispatch
+// overhead.
+//
+// Layout is also incremental: each island's solver inputs are hashed, and
+// when neither the hash nor the assigned rect size changed, the cached
+// geometry from last frame is copied back (translated if the island's
+// origin shifted because an earlier sibling grew).  A keystroke that
+// touches one search box re-solves one island, not the dashboard.
+
+#include "context.h"
+
+#include "task_pool.h"
+
+#include <cstring>
+
+namespace iui {
+
+namespace {
+
+// Trees below this size are solved inline; pool dispatch would dominate.
+constexpr size_t kParallelThreshold = 2048;
+
+float resolved_main(const node &n, iui_axis axis) {
+    return axis == IUI_AXIS_ROW ? n.bounds.w : n.bounds.h;
+}
+
+// Size a node on one axis given its parent's inner extent on that axis.
+float resolve_want(float want, float fit_size, float avail) {
+    if (want == IUI_SIZE_FIT)
+        return fit_size;
+    if (want == IUI_SIZE_FILL)
+        return avail; // FILL on the cross axis; main-axis FILL handled below
+    return want;
+}
+
+// Bottom-up step: accumulate FIT extents into bounds.w/h as provisional
+// sizes.  FILL children contribute nothing to a FIT parent.
+void fit_node(std::vector<node> &nodes, uint32_t i) {
+    node &n = nodes[i];
+    float fit_w = 2.0f * n.padding;
+    float fit_h = 2.0f * n.padding;
+    float main = 0.0f, cross = 0.0f;
+    uint32_t child_count = 0;
+    for (uint32_t c = n.first_child; c; c = nodes[c].next_sibling) {
+        const node &ch = nodes[c];
+        float cw = ch.want_w >= 0.0f ? ch.want_w : ch.bounds.w;
+        float chh = ch.want_h >= 0.0f ? ch.want_h : ch.bounds.h;
+        if (ch.want_w == IUI_SIZE_FILL)
+            cw = 0.0f;
+        if (ch.want_h == IUI_SIZE_FILL)
+            chh = 0.0f;
+        float cm = n.axis == IUI_AXIS_ROW ? cw : chh;
+        float cc = n.axis == IUI_AXIS_ROW ? chh : cw;
+        main += cm;
+        if (cc > cross)
+            cross = cc;
+        ++child_count;
+    }
+    if (child_count > 1)
+        main += n.spacing * (float)(child_count - 1);
+    if (n.axis == IUI_AXIS_ROW) {
+        fit_w += main;
+        fit_h += cross;
+    } else {
+        fit_w += cross;
+        fit_h += main;
+    }
+    n.bounds.w = fit_w;
+    n.bounds.h = fit_h;
+}
+
+// Top-down step: final sizes and positions for i's children; i's own
+// bounds must already be final.  The node's persistent scroll offset (set
+// through iui_slot_set_scroll) shifts the content origin.
+void place_children(iui_context &ctx, uint32_t i) {
+    auto &nodes = ctx.nodes;
+    node &n = nodes[i];
+    if (!n.first_child)
+        return;
+    float inner_x = n.bounds.x + n.padding - ctx.store.scroll_x[n.slot];
+    float inner_y = n.bounds.y + n.padding - ctx.store.scroll_y[n.slot];
+    float inner_w = n.bounds.w - 2.0f * n.padding;
+    float inner_h = n.bounds.h - 2.0f * n.padding;
+    float avail_main = n.axis == IUI_AXIS_ROW ? inner_w : inner_h;
+    float avail_cross = n.axis == IUI_AXIS_ROW ? inner_h : inner_w;
+
+    // First fix non-FILL children and count FILLs on the main axis.
+    uint32_t fill_count = 0, child_count = 0;
+    float used = 0.0f;
+    for (uint32_t c = n.first_child; c; c = nodes[c].next_sibling) {
+        node &ch = nodes[c];
+        float want_main = n.axis == IUI_AXIS_ROW ? ch.want_w : ch.want_h;
+        if (want_main == IUI_SIZE_FILL) {
+            ++fill_count;
+        } else {
+            float fit = resolved_main(ch, n.axis);
+            used += want_main == IUI_SIZE_FIT ? fit : want_main;
+        }
+        ++child_count;
+    }
+    if (child_count > 1)
+        used += n.spacing * (float)(child_count - 1);
+    float fill_each =
+        fill_count ? (avail_main - used) / (float)fill_count : 0.0f;
+    if (fill_each < 0.0f)
+        fill_each = 0.0f;
+
+    float cursor = n.axis == IUI_AXIS_ROW ? inner_x : inner_y;
+    for (uint32_t c = n.first_child; c; c = nodes[c].next_sibling) {
+        node &ch = nodes[c];
+        float want_main = n.axis == IUI_AXIS_ROW ? ch.want_w : ch.want_h;
+        float want_cross = n.axis == IUI_AXIS_ROW ? ch.want_h : ch.want_w;
+        float fit_main = resolved_main(ch, n.axis);
+        float fit_cross = n.axis == IUI_AXIS_ROW ? ch.bounds.h : ch.bounds.w;
+        float main = want_main == IUI_SIZE_FILL
+                         ? fill_each
+                         : resolve_want(want_main, fit_main, avail_main);
+        float cross = resolve_want(want_cross, fit_cross, avail_cross);
+        if (n.axis == IUI_AXIS_ROW) {
+            ch.bounds = iui_rect{cursor, inner_y, main, cross};
+        } else {
+            ch.bounds = iui_rect{inner_x, cursor, cross, main};
+        }
+        cursor += main + n.spacing;
+    }
+}
+
+struct island {
+    uint32_t begin; // island root index
+    uint32_t end;   // one past the last node of the subtree
+    uint64_t input_hash = 0;
+    float fit_w = 0.0f, fit_h = 0.0f; // provisional size after the fit pass
+    bool cache_hit = false; // fit results taken from the layout cache
+};
+
+inline uint64_t hash_float(uint64_t h, float f) {
+    uint32_t bits;
+    memcpy(&bits, &f, sizeof(bits));
+    return hash_mix(h, bits);
+}
+
+// Everything the solver reads for this island: structure (ids in order),
+// sizing inputs and per-slot scroll offsets.  Equal hash + equal assigned
+// rect means the solved geometry is identical up to translation.
+uint64_t island_input_hash(const iui_context &ctx, const island &is) {
+    uint64_t h = 0x69736c6eull;
+    for (uint32_t i = is.begin; i < is.end; ++i) {
+        const node &n = ctx.nodes[i];
+        h = hash_mix(h, n.id_hash);
+        h = hash_float(h, n.want_w);
+        h = hash_float(h, n.want_h);
+        h = hash_float(h, n.padding);
+        h = hash_float(h, n.spacing);
+        h = hash_mix(h, (uint64_t)n.axis);
+        h = hash_float(h, ctx.store.scroll_x[n.slot]);
+        h = hash_float(h, ctx.store.scroll_y[n.slot]);
+    }
+    return h;
+}
+
+} // namespace
+
+void solve_layout(iui_context &ctx) {
+    auto &nodes = ctx.nodes;
+    if (nodes.size() < 2)
+        return;
+
+    nodes[1].bounds = iui_rect{0.0f, 0.0f, ctx.frame_w, ctx.frame_h};
+
+    // Root children partition [2, size) into contiguous subtree ranges.
+    std::vector<island> islands;
+    for (uint32_t c = nodes[1].first_child; c; c = nodes[c].next_sibling) {
+        uint32_t end =
+            nodes[c].next_sibling ? nodes[c].next_sibling : (uint32_t)nodes.size();
+        islands.push_back(island{c, end});
+    }
+
+    // Fit pass per island, consulting the incremental cache: an island
+    // whose inputs are unchanged reuses last frame's provisional size and
+    // skips the walk.
+    auto fit_island = [&](size_t k) {
+        island &is = islands[k];
+        is.input_hash = island_input_hash(ctx, is);
+        auto it = ctx.layout_cache.find(nodes[is.begin].path_hash);
+        if (it != ctx.layout_cache.end() &&
+            it->second.input_hash == is.input_hash &&
+            it->second.bounds.size() == (size_t)(is.end - is.begin)) {
+            nodes[is.begin].bounds.w = it->second.fit_w;
+            nodes[is.begin].bounds.h = it->second.fit_h;
+            is.fit_w = it->second.fit_w;
+            is.fit_h = it->second.fit_h;
+            is.cache_hit = true;
+            return;
+        }
+        for (uint32_t i = is.end - 1; i >= is.begin; --i)
+            fit_node(nodes, i);
+        is.fit_w = nodes[is.begin].bounds.w;
+        is.fit_h = nodes[is.begin].bounds.h;
+    };
+
+    // Place pass per island.  A cache hit whose assigned rect kept its
+    // size only needs a translation of the cached bounds; everything else
+    // is solved and re-cached.  Boundary changes propagate exactly this
+    // way: an island that grew shifts its later siblings, whose cached
+    // geometry is then reused translated.
+    auto place_island = [&](size_t k) {
+        island &is = islands[k];
+        // Entry guaranteed by the sequential step below; no insertion (and
+        // therefore no rehash) happens inside the parallel region.
+        iui_context::island_cache &cache =
+            ctx.layout_cache.find(nodes[is.begin].path_hash)->second;
+        const iui_rect placed = nodes[is.begin].bounds;
+        if (is.cache_hit && cache.placed.w == placed.w &&
+            cache.placed.h == placed.h) {
+            float dx = placed.x - cache.placed.x;
+            float dy = placed.y - cache.placed.y;
+            if (dx != 0.0f || dy != 0.0f) {
+                for (uint32_t i = is.begin; i < is.end; ++i) {
+                    iui_rect r = cache.bounds[i - is.begin];
+                    r.x += dx;
+                    r.y += dy;
+                    nodes[i].bounds = r;
+                    cache.bounds[i - is.begin] = r;
+                }
+                cache.placed = placed;
+            } else {
+                for (uint32_t i = is.begin; i < is.end; ++i)
+                    nodes[i].bounds = cache.bounds[i - is.begin];
+            }
+            return;
+        }
+        if (is.cache_hit) {
+            // Hit whose assigned size changed: the fit walk was skipped,
+            // so the interior nodes still carry this frame's zeroed
+            // provisional sizes.  Rebuild them before the full place.
+            // The island root is excluded — its rect is already final
+            // from the root place pass.
+            for (uint32_t i = is.end - 1; i > is.begin; --i)
+                fit_node(nodes, i);
+        }
+        for (uint32_t i = is.begin; i < is.end; ++i)
+            place_children(ctx, i);
+        cache.input_hash = is.input_hash;
+        cache.fit_w = is.fit_w;
+        cache.fit_h = is.fit_h;
+        cache.placed = placed;
+        cache.bounds.resize(is.end - is.begin);
+        for (uint32_t i = is.begin; i < is.end; ++i)
+            cache.bounds[i - is.begin] = nodes[i].bounds;
+    };
+
+    // Bound the cache when island identities churn (e.g. tab switches).
+    if (ctx.layout_cache.size() > islands.size() * 4 + 64)
+        ctx.layout_cache.clear();
+
+    if (nodes.size() < kParallelThreshold || islands.size() < 2) {
+        for (size_t k = 0; k < islands.size(); ++k)
+            fit_island(k);
+        place_children(ctx, 1); // positions the island roots
+        for (island &is : islands)
+            ctx.layout_cache.try_emplace(nodes[is.begin].path_hash);
+        for (size_t k = 0; k < islands.size(); ++k)
+            place_island(k);
+        return;
+    }
+
+    task_pool &pool = task_pool::instance();
+    pool.parallel_for(islands.size(), fit_island);
+    place_children(ctx, 1); // positions the island roots
+    for (island &is : islands)
+        ctx.layout_cache.try_emplace(nodes[is.begin].path_hash);
+    pool.parallel_for(islands.size(), place_island);
+}
+
+} // namespace iui
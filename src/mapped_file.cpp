@@ -0,0 +1,82 @@
+// mapped_file.cpp — read-only whole-file mappings for POSIX and Windows.
+
+#include "mapped_file.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace iui {
+
+bool mapped_file::map(const char *path) {
+    unmap();
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+    LARGE_INTEGER sz;
+    if (!GetFileSizeEx(file, &sz) || sz.QuadPart <= 0) {
+        CloseHandle(file);
+        return false;
+    }
+    HANDLE mapping =
+        CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+        CloseHandle(file);
+        return false;
+    }
+    const void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+    file_ = file;
+    mapping_ = mapping;
+    data_ = (const uint8_t *)view;
+    size_ = (uint64_t)sz.QuadPart;
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        close(fd);
+        return false;
+    }
+    void *m = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // the mapping keeps the file alive
+    if (m == MAP_FAILED)
+        return false;
+    data_ = (const uint8_t *)m;
+    size_ = (uint64_t)st.st_size;
+#endif
+    return true;
+}
+
+void mapped_file::unmap() {
+    if (!data_)
+        return;
+#ifdef _WIN32
+    UnmapViewOfFile(data_);
+    if (mapping_)
+        CloseHandle((HANDLE)mapping_);
+    if (file_)
+        CloseHandle((HANDLE)file_);
+    mapping_ = nullptr;
+    file_ = nullptr;
+#else
+    munmap((void *)data_, size_);
+#endif
+    data_ = nullptr;
+    size_ = 0;
+}
+
+} // namespace iui
@@ -0,0 +1,37 @@
+// mapped_file.h — small internal wrapper over a read-only file mapping.
+//
+// Shared by the bundle, trace and cache code paths; maps the whole file and
+// unmaps on destruction.
+#ifndef IUI_SRC_MAPPED_FILE_H
+#define IUI_SRC_MAPPED_FILE_H
+
+#include <cstdint>
+
+namespace iui {
+
+class mapped_file {
+  public:
+    mapped_file() = default;
+    ~mapped_file() { unmap(); }
+    mapped_file(const mapped_file &) = delete;
+    mapped_file &operator=(const mapped_file &) = delete;
+
+    bool map(const char *path);
+    void unmap();
+
+    const uint8_t *data() const { return data_; }
+    uint64_t size() const { return size_; }
+    bool valid() const { return data_ != nullptr; }
+
+  private:
+    const uint8_t *data_ = nullptr;
+    uint64_t size_ = 0;
+#ifdef _WIN32
+    void *file_ = nullptr;
+    void *mapping_ = nullptr;
+#endif
+};
+
+} // namespace iui
+
+#endif // IUI_SRC_MAPPED_FILE_H
@@ -0,0 +1,121 @@
+// profiler.cpp — phase timers, counters and the frame-history ring.
+//
+// All state hangs off the context; the ring is a fixed array written
+// round-robin, so steady-state profiling allocates nothing.
+
+#include "iui/profiler.h"
+
+#include "context.h"
+
+#include <chrono>
+#include <cstdio>
+
+namespace iui {
+
+uint64_t now_us() {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+void profile_frame_begin(iui_context &ctx) {
+    profiler_state &p = ctx.profiler;
+    uint64_t now = now_us();
+    if (p.epoch_us == 0)
+        p.epoch_us = now;
+    if (p.frame_open) {
+        // Close the previous frame into the ring.
+        p.current.total_us = (uint32_t)(now - p.frame_start_us);
+        p.ring[p.ring_head] = p.current;
+        p.ring_head = (p.ring_head + 1) % profiler_state::kRingSize;
+        if (p.ring_count < profiler_state::kRingSize)
+            ++p.ring_count;
+    }
+    p.current = iui_frame_profile{};
+    p.current.frame_index = p.next_frame_index++;
+    p.current.start_us = now - p.epoch_us;
+    p.frame_start_us = now;
+    p.frame_open = true;
+}
+
+void profile_phase_add(iui_context &ctx, iui_phase phase, uint64_t us) {
+    if (phase < IUI_PHASE_COUNT)
+        ctx.profiler.current.phase_us[phase] += (uint32_t)us;
+}
+
+} // namespace iui
+
+extern "C" {
+
+void iui_profile_phase_begin(iui_context *ctx, iui_phase phase) {
+    if (!ctx || phase >= IUI_PHASE_COUNT)
+        return;
+    ctx->profiler.phase_start_us[phase] = iui::now_us();
+}
+
+void iui_profile_phase_end(iui_context *ctx, iui_phase phase) {
+    if (!ctx || phase >= IUI_PHASE_COUNT)
+        return;
+    uint64_t start = ctx->profiler.phase_start_us[phase];
+    if (!start)
+        return;
+    ctx->profiler.current.phase_us[phase] +=
+        (uint32_t)(iui::now_us() - start);
+    ctx->profiler.phase_start_us[phase] = 0;
+}
+
+void iui_profile_counter_add(iui_context *ctx, uint32_t slot,
+                             uint32_t amount) {
+    if (!ctx || slot >= IUI_PROFILE_COUNTERS)
+        return;
+    ctx->profiler.current.counters[slot] += amount;
+}
+
+uint32_t iui_profile_history(const iui_context *ctx, iui_frame_profile *out,
+                             uint32_t max) {
+    if (!ctx || !out)
+        return 0;
+    const iui::profiler_state &p = ctx->profiler;
+    uint32_t n = p.ring_count < max ? p.ring_count : max;
+    // Oldest first: start n entries back from the head.
+    uint32_t start =
+        (p.ring_head + iui::profiler_state::kRingSize - n) %
+        iui::profiler_state::kRingSize;
+    for (uint32_t i = 0; i < n; ++i)
+        out[i] = p.ring[(start + i) % iui::profiler_state::kRingSize];
+    return n;
+}
+
+iui_status iui_profile_dump(const iui_context *ctx, const char *path) {
+    if (!ctx || !path)
+        return IUI_ERR_INVALID_ARG;
+    FILE *f = fopen(path, "a");
+    if (!f)
+        return IUI_ERR_IO;
+    static const char *kPhaseNames[IUI_PHASE_COUNT] = {
+        "input", "build", "layout", "text", "geometry", "present"};
+    const iui::profiler_state &p = ctx->profiler;
+    uint32_t start =
+        (p.ring_head + iui::profiler_state::kRingSize - p.ring_count) %
+        iui::profiler_state::kRingSize;
+    for (uint32_t i = 0; i < p.ring_count; ++i) {
+        const iui_frame_profile &fp =
+            p.ring[(start + i) % iui::profiler_state::kRingSize];
+        fprintf(f,
+                "{\"type\":\"profile\",\"frame\":%llu,\"time_us\":%llu,"
+                "\"total_us\":%u",
+                (unsigned long long)fp.frame_index,
+                (unsigned long long)fp.start_us, fp.total_us);
+        for (int ph = 0; ph < IUI_PHASE_COUNT; ++ph)
+            fprintf(f, ",\"%s_us\":%u", kPhaseNames[ph], fp.phase_us[ph]);
+        for (int c = 0; c < IUI_PROFILE_COUNTERS; ++c)
+            if (fp.counters[c])
+                fprintf(f, ",\"c%d\":%u", c, fp.counters[c]);
+        fputs("}\n", f);
+    }
+    if (fclose(f) != 0)
+        return IUI_ERR_IO;
+    return IUI_OK;
+}
+
+} // extern "C"
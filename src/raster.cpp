@@ -0,0 +1,469 @@
+// raster.cpp — scanline triangle rasterizer with SIMD span fills.
+//
+// Each triangle is walked one scanline at a time: the three edge
+// equations reduce to per-line x bounds, so a span is computed with six
+// multiplies and filled flat-out.  Solid opaque spans are 4-wide SSE2
+// stores, solid translucent spans a 4-wide premultiplied blend; textured
+// spans (glyph coverage, images) interpolate u/v from the triangle's
+// plane gradients per pixel.  Quads from the geometry kernel carry one
+// color across their vertices, so spans take the color of the first
+// vertex — per-vertex gradients buy nothing for UI content and would
+// halve the fill rate.
+//
+// The PNG writer emits stored (uncompressed) deflate blocks: a snapshot
+// is written with one pass and no zlib dependency, and the encode cost
+// is memcpy-shaped, which matters more here than the file size.
+
+#include "iui/raster.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <new>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#define IUI_HAVE_SSE2 1
+#include <emmintrin.h>
+#endif
+
+struct iui_raster {
+    uint32_t width = 0;
+    uint32_t height = 0;
+    std::vector<uint32_t> pixels; // premultiplied RGBA8, top-down
+
+    struct texture {
+        uint32_t id;
+        uint32_t width;
+        uint32_t height;
+        iui_raster_format format;
+        std::vector<uint8_t> data;
+    };
+    std::vector<texture> textures;
+};
+
+namespace {
+
+// dst over-blend with premultiplied src; (x * f + 128) trick keeps the
+// /255 exact enough for 8-bit output.
+inline uint32_t blend_pixel(uint32_t dst, uint32_t src) {
+    uint32_t inv = 255 - (src >> 24);
+    uint32_t rb = (dst & 0x00ff00ffu) * inv;
+    rb += 0x00800080u;
+    rb = (rb + ((rb >> 8) & 0x00ff00ffu)) >> 8;
+    uint32_t ag = ((dst >> 8) & 0x00ff00ffu) * inv;
+    ag += 0x00800080u;
+    ag = (ag + ((ag >> 8) & 0x00ff00ffu)) & 0xff00ff00u;
+    return src + (rb & 0x00ff00ffu) + ag;
+}
+
+// Scale all four channels of a premultiplied color by f/255.
+inline uint32_t modulate(uint32_t color, uint32_t f) {
+    uint32_t rb = ((color & 0x00ff00ffu) * f + 0x00800080u);
+    rb = ((rb + ((rb >> 8) & 0x00ff00ffu)) >> 8) & 0x00ff00ffu;
+    uint32_t ag = (((color >> 8) & 0x00ff00ffu) * f + 0x00800080u);
+    ag = (ag + ((ag >> 8) & 0x00ff00ffu)) & 0xff00ff00u;
+    return rb | ag;
+}
+
+// Multiply two premultiplied colors channel-wise (texture * vertex tint).
+inline uint32_t modulate_rgba(uint32_t a, uint32_t b) {
+    uint32_t out = 0;
+    for (int shift = 0; shift < 32; shift += 8) {
+        uint32_t c =
+            ((a >> shift) & 0xffu) * ((b >> shift) & 0xffu) + 128u;
+        c = (c + (c >> 8)) >> 8;
+        out |= c << shift;
+    }
+    return out;
+}
+
+void fill_span_solid(uint32_t *row, int x0, int x1, uint32_t color) {
+    uint32_t a = color >> 24;
+    int x = x0;
+    if (a == 255) {
+#ifdef IUI_HAVE_SSE2
+        __m128i c = _mm_set1_epi32((int)color);
+        for (; x + 4 <= x1; x += 4)
+            _mm_storeu_si128((__m128i *)(row + x), c);
+#endif
+        for (; x < x1; ++x)
+            row[x] = color;
+        return;
+    }
+#ifdef IUI_HAVE_SSE2
+    // dst * (255 - a) on unpacked 16-bit lanes, then add src.
+    __m128i zero = _mm_setzero_si128();
+    __m128i src = _mm_set1_epi32((int)color);
+    __m128i inv = _mm_set1_epi16((short)(255 - a));
+    __m128i half = _mm_set1_epi16(128);
+    for (; x + 4 <= x1; x += 4) {
+        __m128i d = _mm_loadu_si128((const __m128i *)(row + x));
+        __m128i lo = _mm_unpacklo_epi8(d, zero);
+        __m128i hi = _mm_unpackhi_epi8(d, zero);
+        lo = _mm_mullo_epi16(lo, inv);
+        hi = _mm_mullo_epi16(hi, inv);
+        lo = _mm_add_epi16(lo, half);
+        hi = _mm_add_epi16(hi, half);
+        lo = _mm_add_epi16(lo, _mm_srli_epi16(lo, 8));
+        hi = _mm_add_epi16(hi, _mm_srli_epi16(hi, 8));
+        lo = _mm_srli_epi16(lo, 8);
+        hi = _mm_srli_epi16(hi, 8);
+        __m128i out = _mm_packus_epi16(lo, hi);
+        _mm_storeu_si128((__m128i *)(row + x), _mm_add_epi8(out, src));
+    }
+#endif
+    for (; x < x1; ++x)
+        row[x] = blend_pixel(row[x], color);
+}
+
+const iui_raster::texture *find_texture(const iui_raster *r, uint32_t id) {
+    for (const iui_raster::texture &t : r->textures)
+        if (t.id == id)
+            return &t;
+    return nullptr;
+}
+
+struct tri_attr {
+    // u/v as a plane over the triangle: value at (x, y) is
+    // base + dudx * x + dudy * y.
+    float u_base, dudx, dudy;
+    float v_base, dvdx, dvdy;
+};
+
+void fill_span_textured(uint32_t *row, int x0, int x1, float yc,
+                        uint32_t color, const tri_attr &at,
+                        const iui_raster::texture &tex) {
+    float u = at.u_base + at.dudx * ((float)x0 + 0.5f) + at.dudy * yc;
+    float v = at.v_base + at.dvdx * ((float)x0 + 0.5f) + at.dvdy * yc;
+    for (int x = x0; x < x1; ++x, u += at.dudx, v += at.dvdx) {
+        int tx = (int)(u * (float)tex.width);
+        int ty = (int)(v * (float)tex.height);
+        if (tx < 0) tx = 0;
+        if (ty < 0) ty = 0;
+        if (tx >= (int)tex.width) tx = (int)tex.width - 1;
+        if (ty >= (int)tex.height) ty = (int)tex.height - 1;
+        uint32_t src;
+        if (tex.format == IUI_RASTER_A8) {
+            uint8_t cov = tex.data[(size_t)ty * tex.width + tx];
+            if (!cov)
+                continue;
+            src = modulate(color, cov);
+        } else {
+            uint32_t texel;
+            memcpy(&texel,
+                   tex.data.data() + ((size_t)ty * tex.width + tx) * 4, 4);
+            src = modulate_rgba(texel, color);
+        }
+        row[x] = blend_pixel(row[x], src);
+    }
+}
+
+void raster_triangle(iui_raster *r, const iui_vertex &v0,
+                     const iui_vertex &v1, const iui_vertex &v2,
+                     const iui_raster::texture *tex, int cx0, int cy0,
+                     int cx1, int cy1) {
+    const iui_vertex *a = &v0, *b = &v1, *c = &v2;
+    float area = (b->x - a->x) * (c->y - a->y) -
+                 (c->x - a->x) * (b->y - a->y);
+    if (area == 0.0f)
+        return;
+    if (area < 0.0f) { // normalize winding so inside is E >= 0
+        const iui_vertex *t = b;
+        b = c;
+        c = t;
+        area = -area;
+    }
+
+    tri_attr at{};
+    if (tex) {
+        float inv = 1.0f / area;
+        at.dudx = ((b->u - a->u) * (c->y - a->y) -
+                   (c->u - a->u) * (b->y - a->y)) *
+                  inv;
+        at.dudy = ((c->u - a->u) * (b->x - a->x) -
+                   (b->u - a->u) * (c->x - a->x)) *
+                  inv;
+        at.u_base = a->u - at.dudx * a->x - at.dudy * a->y;
+        at.dvdx = ((b->v - a->v) * (c->y - a->y) -
+                   (c->v - a->v) * (b->y - a->y)) *
+                  inv;
+        at.dvdy = ((c->v - a->v) * (b->x - a->x) -
+                   (b->v - a->v) * (c->x - a->x)) *
+                  inv;
+        at.v_base = a->v - at.dvdx * a->x - at.dvdy * a->y;
+    }
+
+    float min_y = a->y, max_y = a->y;
+    if (b->y < min_y) min_y = b->y;
+    if (c->y < min_y) min_y = c->y;
+    if (b->y > max_y) max_y = b->y;
+    if (c->y > max_y) max_y = c->y;
+    int y0 = (int)std::floor(min_y + 0.5f);
+    int y1 = (int)std::ceil(max_y - 0.5f);
+    if (y0 < cy0) y0 = cy0;
+    if (y1 > cy1) y1 = cy1;
+
+    const iui_vertex *ea[3] = {a, b, c};
+    const iui_vertex *eb[3] = {b, c, a};
+    for (int y = y0; y < y1; ++y) {
+        float yc = (float)y + 0.5f;
+        // Each edge constrains x on one side; d == 0 edges only accept or
+        // reject the whole line.
+        float xl = (float)cx0, xr = (float)cx1;
+        bool empty = false;
+        for (int e = 0; e < 3; ++e) {
+            float d = eb[e]->y - ea[e]->y;
+            float k = (eb[e]->x - ea[e]->x) * (yc - ea[e]->y) +
+                      d * ea[e]->x;
+            if (d > 0.0f) {
+                float bound = k / d;
+                if (bound < xr) xr = bound;
+            } else if (d < 0.0f) {
+                float bound = k / d;
+                if (bound > xl) xl = bound;
+            } else if ((eb[e]->x - ea[e]->x) * (yc - ea[e]->y) < 0.0f) {
+                empty = true;
+                break;
+            }
+        }
+        if (empty)
+            continue;
+        int x0 = (int)std::floor(xl + 0.5f);
+        int x1 = (int)std::ceil(xr - 0.5f);
+        if (x0 < cx0) x0 = cx0;
+        if (x1 > cx1) x1 = cx1;
+        if (x0 >= x1)
+            continue;
+        uint32_t *row = r->pixels.data() + (size_t)y * r->width;
+        if (tex)
+            fill_span_textured(row, x0, x1, yc, a->color, at, *tex);
+        else
+            fill_span_solid(row, x0, x1, a->color);
+    }
+}
+
+// --- PNG output: stored-deflate IDAT, filter 0 rows ---------------------
+
+uint32_t crc32_png(const uint8_t *data, size_t size, uint32_t crc) {
+    static uint32_t table[256];
+    static bool init = false;
+    if (!init) {
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; ++k)
+                c = (c & 1) ? 0xedb88320u ^ (c >> 1) : c >> 1;
+            table[i] = c;
+        }
+        init = true;
+    }
+    crc = ~crc;
+    for (size_t i = 0; i < size; ++i)
+        crc = table[(crc ^ data[i]) & 0xffu] ^ (crc >> 8);
+    return ~crc;
+}
+
+void put_be32(std::vector<uint8_t> &out, uint32_t v) {
+    out.push_back((uint8_t)(v >> 24));
+    out.push_back((uint8_t)(v >> 16));
+    out.push_back((uint8_t)(v >> 8));
+    out.push_back((uint8_t)v);
+}
+
+void put_chunk(FILE *f, const char *type, const std::vector<uint8_t> &data) {
+    uint8_t len[4] = {(uint8_t)(data.size() >> 24),
+                      (uint8_t)(data.size() >> 16),
+                      (uint8_t)(data.size() >> 8), (uint8_t)data.size()};
+    fwrite(len, 1, 4, f);
+    fwrite(type, 1, 4, f);
+    if (!data.empty())
+        fwrite(data.data(), 1, data.size(), f);
+    uint32_t crc = crc32_png((const uint8_t *)type, 4, 0);
+    crc = crc32_png(data.data(), data.size(), crc);
+    uint8_t crcb[4] = {(uint8_t)(crc >> 24), (uint8_t)(crc >> 16),
+                       (uint8_t)(crc >> 8), (uint8_t)crc};
+    fwrite(crcb, 1, 4, f);
+}
+
+} // namespace
+
+extern "C" {
+
+iui_raster *iui_raster_create(uint32_t width, uint32_t height) {
+    if (width == 0 || height == 0 || width > 16384 || height > 16384)
+        return nullptr;
+    iui_raster *r = new (std::nothrow) iui_raster();
+    if (!r)
+        return nullptr;
+    r->width = width;
+    r->height = height;
+    r->pixels.resize((size_t)width * height, 0);
+    return r;
+}
+
+void iui_raster_destroy(iui_raster *r) {
+    delete r;
+}
+
+void iui_raster_clear(iui_raster *r, uint32_t color) {
+    if (!r)
+        return;
+    for (uint32_t &p : r->pixels)
+        p = color;
+}
+
+iui_status iui_raster_set_texture(iui_raster *r, uint32_t id,
+                                  const void *pixels, uint32_t width,
+                                  uint32_t height, iui_raster_format format) {
+    if (!r || !pixels || width == 0 || height == 0 || id == 0)
+        return IUI_ERR_INVALID_ARG;
+    size_t bytes =
+        (size_t)width * height * (format == IUI_RASTER_RGBA8 ? 4 : 1);
+    for (iui_raster::texture &t : r->textures) {
+        if (t.id == id) {
+            t.width = width;
+            t.height = height;
+            t.format = format;
+            t.data.assign((const uint8_t *)pixels,
+                          (const uint8_t *)pixels + bytes);
+            return IUI_OK;
+        }
+    }
+    iui_raster::texture t;
+    t.id = id;
+    t.width = width;
+    t.height = height;
+    t.format = format;
+    t.data.assign((const uint8_t *)pixels, (const uint8_t *)pixels + bytes);
+    r->textures.push_back(std::move(t));
+    return IUI_OK;
+}
+
+iui_status iui_raster_execute(iui_raster *r, const iui_cmd_buffer *cb) {
+    if (!r || !cb)
+        return IUI_ERR_INVALID_ARG;
+    const iui_draw_batch *batches = nullptr;
+    uint32_t batch_count = iui_cmd_buffer_batches(cb, &batches);
+    uint32_t vertex_count = 0, index_count = 0;
+    const iui_vertex *vertices = iui_cmd_buffer_vertices(cb, &vertex_count);
+    const uint32_t *indices = iui_cmd_buffer_indices(cb, &index_count);
+    if (batch_count && (!vertices || !indices))
+        return IUI_ERR_BAD_STATE; // finish was not called
+
+    for (uint32_t bi = 0; bi < batch_count; ++bi) {
+        const iui_draw_batch &batch = batches[bi];
+        const iui_raster::texture *tex =
+            batch.texture ? find_texture(r, batch.texture) : nullptr;
+        if (batch.texture && !tex)
+            continue; // unregistered texture: skip, matching GPU bind miss
+        int cx0 = 0, cy0 = 0, cx1 = (int)r->width, cy1 = (int)r->height;
+        if (batch.scissor_enabled) {
+            if ((int)batch.scissor.x > cx0) cx0 = (int)batch.scissor.x;
+            if ((int)batch.scissor.y > cy0) cy0 = (int)batch.scissor.y;
+            int sx1 = (int)(batch.scissor.x + batch.scissor.w);
+            int sy1 = (int)(batch.scissor.y + batch.scissor.h);
+            if (sx1 < cx1) cx1 = sx1;
+            if (sy1 < cy1) cy1 = sy1;
+            if (cx0 >= cx1 || cy0 >= cy1)
+                continue;
+        }
+        uint32_t end = batch.index_offset + batch.index_count;
+        if (end > index_count)
+            return IUI_ERR_CORRUPT;
+        for (uint32_t i = batch.index_offset; i + 2 < end; i += 3) {
+            uint32_t i0 = indices[i], i1 = indices[i + 1],
+                     i2 = indices[i + 2];
+            if (i0 >= vertex_count || i1 >= vertex_count ||
+                i2 >= vertex_count)
+                return IUI_ERR_CORRUPT;
+            raster_triangle(r, vertices[i0], vertices[i1], vertices[i2],
+                            tex, cx0, cy0, cx1, cy1);
+        }
+    }
+    return IUI_OK;
+}
+
+const uint8_t *iui_raster_pixels(const iui_raster *r, uint32_t *width,
+                                 uint32_t *height) {
+    if (!r)
+        return nullptr;
+    if (width)
+        *width = r->width;
+    if (height)
+        *height = r->height;
+    return (const uint8_t *)r->pixels.data();
+}
+
+iui_status iui_raster_write_png(const iui_raster *r, const char *path) {
+    if (!r || !path)
+        return IUI_ERR_INVALID_ARG;
+    FILE *f = fopen(path, "wb");
+    if (!f)
+        return IUI_ERR_IO;
+    static const uint8_t sig[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1a,
+                                   '\n'};
+    fwrite(sig, 1, 8, f);
+
+    std::vector<uint8_t> ihdr;
+    put_be32(ihdr, r->width);
+    put_be32(ihdr, r->height);
+    ihdr.push_back(8); // bit depth
+    ihdr.push_back(6); // color type RGBA
+    ihdr.push_back(0);
+    ihdr.push_back(0);
+    ihdr.push_back(0);
+    put_chunk(f, "IHDR", ihdr);
+
+    // zlib stream of stored deflate blocks; one filter-0 byte per row.
+    size_t row_bytes = (size_t)r->width * 4;
+    size_t raw_size = ((size_t)r->height) * (row_bytes + 1);
+    std::vector<uint8_t> raw;
+    raw.reserve(raw_size);
+    uint32_t s1 = 1, s2 = 0; // adler32 over the raw stream
+    for (uint32_t y = 0; y < r->height; ++y) {
+        raw.push_back(0);
+        const uint8_t *row =
+            (const uint8_t *)(r->pixels.data() + (size_t)y * r->width);
+        raw.insert(raw.end(), row, row + row_bytes);
+    }
+    for (uint8_t byte : raw) {
+        s1 = (s1 + byte) % 65521;
+        s2 = (s2 + s1) % 65521;
+    }
+
+    std::vector<uint8_t> idat;
+    idat.reserve(raw.size() + raw.size() / 65535 * 5 + 16);
+    idat.push_back(0x78); // zlib header, 32K window, no preset dict
+    idat.push_back(0x01);
+    size_t off = 0;
+    while (off < raw.size()) {
+        size_t n = raw.size() - off;
+        if (n > 65535)
+            n = 65535;
+        idat.push_back(off + n == raw.size() ? 1 : 0); // BFINAL
+        idat.push_back((uint8_t)n);
+        idat.push_back((uint8_t)(n >> 8));
+        idat.push_back((uint8_t)~n);
+        idat.push_back((uint8_t)(~n >> 8));
+        idat.insert(idat.end(), raw.begin() + (long)off,
+                    raw.begin() + (long)(off + n));
+        off += n;
+    }
+    put_be32(idat, (s2 << 16) | s1);
+    put_chunk(f, "IDAT", idat);
+    put_chunk(f, "IEND", std::vector<uint8_t>());
+    return fclose(f) == 0 ? IUI_OK : IUI_ERR_IO;
+}
+
+iui_status iui_raster_write_raw(const iui_raster *r, const char *path) {
+    if (!r || !path)
+        return IUI_ERR_INVALID_ARG;
+    FILE *f = fopen(path, "wb");
+    if (!f)
+        return IUI_ERR_IO;
+    size_t count = (size_t)r->width * r->height;
+    bool ok = fwrite(r->pixels.data(), 4, count, f) == count;
+    return (fclose(f) == 0 && ok) ? IUI_OK : IUI_ERR_IO;
+}
+
+} // extern "C"
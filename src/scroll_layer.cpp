@@ -0,0 +1,129 @@
+// scroll_layer.cpp — strip planning for GPU-resident scroll panes.
+//
+// The ring invariant: content row y is stored at texture row
+// fmod(y, layer_h), and the rows whose pixels are current form one
+// contiguous content range [res0, res1) no taller than the ring.  Each
+// update slides that range to cover the new view, re-rendering only the
+// slice that scrolled in; scrolling back within the resident slack is a
+// pure blit.  Invalidations from the damage engine are folded into the
+// same strip list.
+
+#include "iui/layer.h"
+
+#include "context.h"
+
+#include <cmath>
+
+namespace {
+
+// Append [y0, y1) as strips, split where the ring wraps so each strip
+// lands contiguously in the texture.
+uint32_t emit_strips(const iui_scroll_layer &l, float y0, float y1,
+                     iui_rect *out, uint32_t count) {
+    while (y0 < y1 && count < IUI_LAYER_MAX_STRIPS) {
+        float wrap = (std::floor(y0 / l.layer_h) + 1.0f) * l.layer_h;
+        float end = y1 < wrap ? y1 : wrap;
+        out[count++] = iui_rect{0.0f, y0, l.view_w, end - y0};
+        y0 = end;
+    }
+    return count;
+}
+
+} // namespace
+
+extern "C" {
+
+iui_scroll_layer *iui_scroll_layer_get(iui_context *ctx, iui_widget w,
+                                       float view_w, float view_h,
+                                       float layer_h) {
+    if (!ctx || w >= ctx->nodes.size() || view_w <= 0.0f || view_h <= 0.0f)
+        return nullptr;
+    if (layer_h < view_h)
+        layer_h = view_h;
+    iui_scroll_layer &l = ctx->scroll_layers[ctx->nodes[w].path_hash];
+    if (l.view_w != view_w || l.view_h != view_h || l.layer_h != layer_h) {
+        uint32_t tex = l.texture; // renderer handle survives the reset
+        l = iui_scroll_layer{};
+        l.view_w = view_w;
+        l.view_h = view_h;
+        l.layer_h = layer_h;
+        l.texture = tex;
+    }
+    return &l;
+}
+
+void iui_scroll_layer_set_texture(iui_scroll_layer *l, uint32_t tex) {
+    if (l)
+        l->texture = tex;
+}
+
+uint32_t iui_scroll_layer_texture(const iui_scroll_layer *l) {
+    return l ? l->texture : 0;
+}
+
+uint32_t iui_scroll_layer_update(iui_scroll_layer *l, float scroll_y,
+                                 iui_rect strips_out[4]) {
+    if (!l)
+        return 0;
+    float view0 = scroll_y;
+    float view1 = scroll_y + l->view_h;
+    uint32_t count = 0;
+
+    // A first frame, a reset, or a jump past everything resident means
+    // the whole view renders fresh.
+    if (!l->valid || view1 <= l->res0 || view0 >= l->res1) {
+        count = emit_strips(*l, view0, view1, strips_out, count);
+        l->res0 = view0;
+        l->res1 = view1;
+        l->valid = true;
+        l->dirty1 = l->dirty0; // fresh pixels, nothing stale left
+        return count;
+    }
+
+    // Strips that scrolled into view on either side of the resident range.
+    // Growing one end overwrites ring rows at the other, so the far end is
+    // trimmed to keep the range no taller than the ring.
+    if (view0 < l->res0) {
+        count = emit_strips(*l, view0, l->res0, strips_out, count);
+        l->res0 = view0;
+        if (l->res1 > l->res0 + l->layer_h)
+            l->res1 = l->res0 + l->layer_h;
+    }
+    if (view1 > l->res1) {
+        count = emit_strips(*l, l->res1, view1, strips_out, count);
+        l->res1 = view1;
+        if (l->res0 < l->res1 - l->layer_h)
+            l->res0 = l->res1 - l->layer_h;
+    }
+
+    // Invalidated content that is still resident re-renders in place.
+    float d0 = l->dirty0 > l->res0 ? l->dirty0 : l->res0;
+    float d1 = l->dirty1 < l->res1 ? l->dirty1 : l->res1;
+    if (d0 < d1)
+        count = emit_strips(*l, d0, d1, strips_out, count);
+    l->dirty1 = l->dirty0;
+    return count;
+}
+
+float iui_scroll_layer_texture_y(const iui_scroll_layer *l, float y) {
+    if (!l || l->layer_h <= 0.0f)
+        return 0.0f;
+    float r = std::fmod(y, l->layer_h);
+    return r < 0.0f ? r + l->layer_h : r;
+}
+
+void iui_scroll_layer_invalidate(iui_scroll_layer *l, float y0, float y1) {
+    if (!l || y1 <= y0)
+        return;
+    if (l->dirty1 <= l->dirty0) {
+        l->dirty0 = y0;
+        l->dirty1 = y1;
+        return;
+    }
+    if (y0 < l->dirty0)
+        l->dirty0 = y0;
+    if (y1 > l->dirty1)
+        l->dirty1 = y1;
+}
+
+} // extern "C"
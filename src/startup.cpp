@@ -0,0 +1,86 @@
+// startup.cpp — the process-wide startup mark table.
+//
+// Fixed storage, no locks beyond one atomic cursor: startup is
+// effectively single-threaded, but present threads and the image workers
+// exist before the first frame, so marks from them must not tear.
+
+#include "iui/startup.h"
+
+#include "context.h" // now_us
+
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+struct mark {
+    char phase[32];
+    uint64_t t_us; // since anchor
+};
+
+struct startup_state {
+    std::atomic<uint32_t> count{0};
+    std::atomic<uint64_t> anchor_us{0};
+    mark marks[IUI_STARTUP_MAX_MARKS];
+};
+
+startup_state g_startup;
+
+} // namespace
+
+extern "C" {
+
+void iui_startup_begin(void) {
+    g_startup.anchor_us.store(iui::now_us(), std::memory_order_relaxed);
+    g_startup.count.store(0, std::memory_order_release);
+}
+
+void iui_startup_mark(const char *phase) {
+    if (!phase)
+        return;
+    uint64_t now = iui::now_us();
+    uint64_t anchor = g_startup.anchor_us.load(std::memory_order_relaxed);
+    if (anchor == 0) { // no explicit begin: first mark anchors at zero
+        g_startup.anchor_us.compare_exchange_strong(
+            anchor, now, std::memory_order_relaxed);
+        anchor = g_startup.anchor_us.load(std::memory_order_relaxed);
+    }
+    uint32_t i = g_startup.count.fetch_add(1, std::memory_order_acq_rel);
+    if (i >= IUI_STARTUP_MAX_MARKS) {
+        g_startup.count.store(IUI_STARTUP_MAX_MARKS,
+                              std::memory_order_release);
+        return;
+    }
+    mark &m = g_startup.marks[i];
+    snprintf(m.phase, sizeof(m.phase), "%s", phase);
+    m.t_us = now - anchor;
+}
+
+iui_status iui_startup_write(const char *path) {
+    if (!path)
+        return IUI_ERR_INVALID_ARG;
+    FILE *f = fopen(path, "wb");
+    if (!f)
+        return IUI_ERR_IO;
+    uint32_t n = g_startup.count.load(std::memory_order_acquire);
+    if (n > IUI_STARTUP_MAX_MARKS)
+        n = IUI_STARTUP_MAX_MARKS;
+    uint64_t prev = 0;
+    for (uint32_t i = 0; i < n; ++i) {
+        const mark &m = g_startup.marks[i];
+        fprintf(f,
+                "{\"phase\":\"%s\",\"t_us\":%llu,\"dt_us\":%llu}\n",
+                m.phase, (unsigned long long)m.t_us,
+                (unsigned long long)(m.t_us - prev));
+        prev = m.t_us;
+    }
+    return fclose(f) == 0 ? IUI_OK : IUI_ERR_IO;
+}
+
+uint32_t iui_startup_count(void) {
+    uint32_t n = g_startup.count.load(std::memory_order_acquire);
+    return n > IUI_STARTUP_MAX_MARKS ? IUI_STARTUP_MAX_MARKS : n;
+}
+
+} // extern "C"
@@ -0,0 +1,102 @@
+// task_pool.cpp — see task_pool.h for the scheduling model.
+
+#include "task_pool.h"
+
+namespace iui {
+
+namespace {
+
+std::atomic<unsigned> g_requested_threads{0};
+
+} // namespace
+
+void task_pool::set_requested_threads(unsigned n) {
+    g_requested_threads.store(n, std::memory_order_relaxed);
+}
+
+task_pool &task_pool::instance() {
+    static task_pool pool([] {
+        unsigned n = g_requested_threads.load(std::memory_order_relaxed);
+        if (n == 0)
+            n = std::thread::hardware_concurrency();
+        if (n == 0)
+            n = 1;
+        return n > 1 ? n - 1 : 0; // the calling thread is a worker too
+    }());
+    return pool;
+}
+
+task_pool::task_pool(unsigned workers) {
+    workers_.reserve(workers);
+    for (unsigned i = 0; i < workers; ++i)
+        workers_.emplace_back([this, i] { worker_loop(i); });
+}
+
+task_pool::~task_pool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    work_cv_.notify_all();
+    for (std::thread &t : workers_)
+        t.join();
+}
+
+bool task_pool::run_some(batch *b) {
+    size_t i = b->next.fetch_add(1, std::memory_order_relaxed);
+    if (i >= b->count)
+        return false;
+    (*b->fn)(i);
+    b->done.fetch_add(1, std::memory_order_acq_rel);
+    return true;
+}
+
+void task_pool::worker_loop(unsigned) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        work_cv_.wait(lock, [this] { return stop_ || current_; });
+        if (stop_)
+            return;
+        batch *b = current_;
+        b->refs.fetch_add(1, std::memory_order_relaxed);
+        lock.unlock();
+        while (run_some(b)) {
+        }
+        lock.lock();
+        if (current_ == b)
+            current_ = nullptr; // exhausted; let other workers sleep
+        // Last reference signals the submitter under the lock, so the
+        // stack-allocated batch cannot be torn down while we touch it.
+        if (b->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            done_cv_.notify_all();
+    }
+}
+
+void task_pool::parallel_for(size_t n, const std::function<void(size_t)> &fn) {
+    if (n == 0)
+        return;
+    if (workers_.empty() || n == 1) {
+        for (size_t i = 0; i < n; ++i)
+            fn(i);
+        return;
+    }
+    batch b;
+    b.fn = &fn;
+    b.count = n;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        current_ = &b;
+    }
+    work_cv_.notify_all();
+    while (run_some(&b)) {
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (current_ == &b)
+        current_ = nullptr;
+    done_cv_.wait(lock, [&b] {
+        return b.done.load(std::memory_order_acquire) == b.count &&
+               b.refs.load(std::memory_order_acquire) == 0;
+    });
+}
+
+} // namespace iui
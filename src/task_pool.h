@@ -0,0 +1,66 @@
+// task_pool.h — internal thread pool with stealing at item granularity.
+//
+// parallel_for batches are claimed item by item off a shared atomic
+// cursor: a worker that finishes its item immediately steals the next
+// unclaimed one, so uneven islands (one huge panel among many small ones)
+// balance themselves without per-worker queues.  Used by the parallel
+// layout solver and the sharded trace reader; the pool is lazily created
+// on first use and sized to the hardware unless overridden through
+// iui_set_worker_threads.
+#ifndef IUI_SRC_TASK_POOL_H
+#define IUI_SRC_TASK_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace iui {
+
+class task_pool {
+  public:
+    // Shared pool; respects the thread-count override if set before first
+    // use.
+    static task_pool &instance();
+
+    explicit task_pool(unsigned workers);
+    ~task_pool();
+    task_pool(const task_pool &) = delete;
+    task_pool &operator=(const task_pool &) = delete;
+
+    // Run fn(0..n-1); the calling thread participates.  Blocks until all
+    // items completed.  Safe to call with n == 0.
+    void parallel_for(size_t n, const std::function<void(size_t)> &fn);
+
+    unsigned worker_count() const { return (unsigned)workers_.size(); }
+
+    // 0 = pick from hardware_concurrency.  Takes effect when the shared
+    // pool is first created.
+    static void set_requested_threads(unsigned n);
+
+  private:
+    struct batch {
+        const std::function<void(size_t)> *fn;
+        std::atomic<size_t> next{0};
+        std::atomic<size_t> done{0};
+        std::atomic<int> refs{0}; // workers currently inside this batch
+        size_t count = 0;
+    };
+
+    void worker_loop(unsigned index);
+    bool run_some(batch *b);
+
+    std::vector<std::thread> workers_;
+    std::mutex mutex_;
+    std::condition_variable work_cv_;
+    std::condition_variable done_cv_;
+    batch *current_ = nullptr;
+    bool stop_ = false;
+};
+
+} // namespace iui
+
+#endif // IUI_SRC_TASK_POOL_H
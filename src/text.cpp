@@ -0,0 +1,478 @@
+// text.cpp — glyph atlas packing and the shaped-run cache.
+//
+// The atlas is a single A8 bitmap filled by a shelf packer: glyphs go left
+// to right on the current shelf, a taller glyph opens a new shelf.  Glyphs
+// are cached per (font, codepoint), shaped runs per (font, string hash).
+// Run eviction is clock-based: iui_text_frame stamps the frame, and when
+// the run cache outgrows its budget, runs idle for kEvictAge frames are
+// dropped.  Glyphs are never evicted — the atlas only grows, which is what
+// keeps hit cost at exactly one hash lookup.
+
+#include "iui/text.h"
+
+#include "iui/intern.h"
+#include "iui/startup.h"
+
+#include "context.h" // hash_mix / hash_id
+#include "intern.h"
+#include "mapped_file.h"
+
+#include <cstdio>
+#include <cstring>
+#include <new>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+constexpr size_t kRunBudget = 4096; // cached runs before eviction kicks in
+constexpr uint32_t kEvictAge = 300; // frames a run may sit unused
+constexpr uint32_t kGlyphPad = 1;   // atlas gutter against bleeding
+
+struct glyph_entry {
+    iui_glyph_metrics metrics;
+    float u0, v0, u1, v1;
+};
+
+struct font_entry {
+    iui_font_desc desc;
+    bool builtin;
+};
+
+struct run_key {
+    uint64_t text_hash;
+    uint32_t font;
+    bool operator==(const run_key &o) const {
+        return text_hash == o.text_hash && font == o.font;
+    }
+};
+
+struct run_key_hash {
+    size_t operator()(const run_key &k) const {
+        return (size_t)iui::hash_mix(k.text_hash, k.font);
+    }
+};
+
+struct run_entry {
+    std::vector<iui_glyph_quad> quads;
+    iui_shaped_run run;
+    uint32_t last_used_frame;
+};
+
+// Builtin monospace block font: a filled box with a 1 px inset, enough to
+// exercise layout, the atlas and the render path without any font files.
+constexpr float kBuiltinSize = 13.0f;
+
+int builtin_metrics(void *, uint32_t codepoint, iui_glyph_metrics *out) {
+    out->advance = kBuiltinSize * 0.6f;
+    if (codepoint == ' ' || codepoint == '\t') {
+        out->bearing_x = out->bearing_y = 0.0f;
+        out->width = out->height = 0;
+        return 1;
+    }
+    out->bearing_x = 1.0f;
+    out->bearing_y = kBuiltinSize - 3.0f;
+    out->width = (uint32_t)(kBuiltinSize * 0.6f) - 2;
+    out->height = (uint32_t)kBuiltinSize - 4;
+    return 1;
+}
+
+void builtin_rasterize(void *, uint32_t, uint8_t *out, uint32_t width,
+                       uint32_t height) {
+    for (uint32_t y = 0; y < height; ++y)
+        for (uint32_t x = 0; x < width; ++x)
+            out[y * width + x] =
+                (x == 0 || y == 0 || x + 1 == width || y + 1 == height) ? 96
+                                                                        : 255;
+}
+
+// Minimal UTF-8 decode; invalid bytes map to U+FFFD and advance by one so
+// broken input cannot loop.
+uint32_t decode_utf8(const char *&p, const char *end) {
+    uint8_t b0 = (uint8_t)*p++;
+    if (b0 < 0x80)
+        return b0;
+    uint32_t cp;
+    int extra;
+    if ((b0 & 0xe0) == 0xc0) {
+        cp = b0 & 0x1f;
+        extra = 1;
+    } else if ((b0 & 0xf0) == 0xe0) {
+        cp = b0 & 0x0f;
+        extra = 2;
+    } else if ((b0 & 0xf8) == 0xf0) {
+        cp = b0 & 0x07;
+        extra = 3;
+    } else {
+        return 0xfffd;
+    }
+    for (int i = 0; i < extra; ++i) {
+        if (p >= end || ((uint8_t)*p & 0xc0) != 0x80)
+            return 0xfffd;
+        cp = (cp << 6) | ((uint8_t)*p++ & 0x3f);
+    }
+    return cp;
+}
+
+} // namespace
+
+struct iui_text_system {
+    std::vector<font_entry> fonts; // index 0 unused (IUI_INVALID_FONT)
+    std::vector<uint8_t> atlas;
+    uint32_t atlas_w = 0, atlas_h = 0;
+    uint32_t atlas_version = 0;
+    // Shelf packer cursor.
+    uint32_t shelf_x = 0, shelf_y = 0, shelf_h = 0;
+    bool atlas_full = false;
+
+    std::unordered_map<uint64_t, glyph_entry> glyphs; // (font, codepoint)
+    std::unordered_map<run_key, run_entry, run_key_hash> runs;
+    uint32_t frame = 0;
+    std::vector<uint8_t> raster_scratch;
+
+    const glyph_entry *get_glyph(iui_font font, uint32_t codepoint);
+};
+
+const glyph_entry *iui_text_system::get_glyph(iui_font font,
+                                              uint32_t codepoint) {
+    uint64_t key = iui::hash_mix((uint64_t)font << 32 | codepoint, 0x67);
+    auto it = glyphs.find(key);
+    if (it != glyphs.end())
+        return &it->second;
+
+    const font_entry &fe = fonts[font];
+    glyph_entry g{};
+    if (!fe.desc.metrics(fe.desc.user, codepoint, &g.metrics))
+        return nullptr;
+
+    if (g.metrics.width && g.metrics.height) {
+        uint32_t w = g.metrics.width + 2 * kGlyphPad;
+        uint32_t h = g.metrics.height + 2 * kGlyphPad;
+        if (shelf_x + w > atlas_w) { // open a new shelf
+            shelf_y += shelf_h;
+            shelf_x = 0;
+            shelf_h = 0;
+        }
+        if (shelf_y + h > atlas_h || w > atlas_w) {
+            atlas_full = true; // glyph renders as empty; atlas too small
+        } else {
+            uint32_t gx = shelf_x + kGlyphPad, gy = shelf_y + kGlyphPad;
+            raster_scratch.resize((size_t)g.metrics.width * g.metrics.height);
+            fe.desc.rasterize(fe.desc.user, codepoint, raster_scratch.data(),
+                              g.metrics.width, g.metrics.height);
+            for (uint32_t y = 0; y < g.metrics.height; ++y)
+                memcpy(&atlas[(size_t)(gy + y) * atlas_w + gx],
+                       &raster_scratch[(size_t)y * g.metrics.width],
+                       g.metrics.width);
+            g.u0 = (float)gx / (float)atlas_w;
+            g.v0 = (float)gy / (float)atlas_h;
+            g.u1 = (float)(gx + g.metrics.width) / (float)atlas_w;
+            g.v1 = (float)(gy + g.metrics.height) / (float)atlas_h;
+            shelf_x += w;
+            if (h > shelf_h)
+                shelf_h = h;
+            ++atlas_version;
+        }
+    }
+    return &glyphs.emplace(key, g).first->second;
+}
+
+extern "C" {
+
+iui_text_system *iui_text_create(uint32_t atlas_width, uint32_t atlas_height) {
+    if (!atlas_width || !atlas_height)
+        return nullptr;
+    iui_text_system *ts = new (std::nothrow) iui_text_system();
+    if (!ts)
+        return nullptr;
+    ts->atlas_w = atlas_width;
+    ts->atlas_h = atlas_height;
+    ts->atlas.assign((size_t)atlas_width * atlas_height, 0);
+    ts->fonts.emplace_back(); // slot 0 = invalid
+    return ts;
+}
+
+void iui_text_destroy(iui_text_system *ts) {
+    delete ts;
+}
+
+iui_font iui_text_register_font(iui_text_system *ts,
+                                const iui_font_desc *desc) {
+    if (!ts)
+        return IUI_INVALID_FONT;
+    font_entry fe{};
+    if (desc && desc->metrics && desc->rasterize) {
+        fe.desc = *desc;
+        fe.builtin = false;
+    } else {
+        fe.desc.size_px = kBuiltinSize;
+        fe.desc.user = nullptr;
+        fe.desc.metrics = builtin_metrics;
+        fe.desc.rasterize = builtin_rasterize;
+        fe.builtin = true;
+    }
+    ts->fonts.push_back(fe);
+    return (iui_font)(ts->fonts.size() - 1);
+}
+
+static const iui_shaped_run *shape_hashed(iui_text_system *ts, iui_font font,
+                                          const char *text, size_t len,
+                                          uint64_t h) {
+    run_key key{h, font};
+    auto it = ts->runs.find(key);
+    if (it != ts->runs.end()) {
+        it->second.last_used_frame = ts->frame;
+        return &it->second.run;
+    }
+
+    run_entry entry;
+    entry.last_used_frame = ts->frame;
+    float pen = 0.0f;
+    const char *p = text, *end = text + len;
+    while (p < end) {
+        uint32_t cp = decode_utf8(p, end);
+        const glyph_entry *g = ts->get_glyph(font, cp);
+        if (!g)
+            continue;
+        if (g->metrics.width && g->metrics.height) {
+            iui_glyph_quad q;
+            q.x0 = pen + g->metrics.bearing_x;
+            q.y0 = -g->metrics.bearing_y;
+            q.x1 = q.x0 + (float)g->metrics.width;
+            q.y1 = q.y0 + (float)g->metrics.height;
+            q.u0 = g->u0;
+            q.v0 = g->v0;
+            q.u1 = g->u1;
+            q.v1 = g->v1;
+            entry.quads.push_back(q);
+        }
+        pen += g->metrics.advance;
+    }
+    entry.run.quads = entry.quads.data();
+    entry.run.glyph_count = (uint32_t)entry.quads.size();
+    entry.run.width = pen;
+    entry.run.height = ts->fonts[font].desc.size_px;
+
+    auto ins = ts->runs.emplace(key, std::move(entry)).first;
+    ins->second.run.quads = ins->second.quads.data();
+    return &ins->second.run;
+}
+
+const iui_shaped_run *iui_text_shape(iui_text_system *ts, iui_font font,
+                                     const char *text, size_t len) {
+    if (!ts || !text || font == IUI_INVALID_FONT ||
+        font >= ts->fonts.size())
+        return nullptr;
+    if (len == 0)
+        len = strlen(text);
+
+    uint64_t h = 1469598103934665603ull;
+    for (size_t i = 0; i < len; ++i) {
+        h ^= (uint8_t)text[i];
+        h *= 1099511628211ull;
+    }
+    return shape_hashed(ts, font, text, len, h);
+}
+
+const iui_shaped_run *iui_text_shape_h(iui_text_system *ts, iui_font font,
+                                       iui_str s) {
+    iui::intern_ref ref;
+    if (!ts || font == IUI_INVALID_FONT || font >= ts->fonts.size() ||
+        !iui::intern_lookup(s, ref))
+        return nullptr;
+    // The intern table stores the same FNV-1a, so handle and string
+    // lookups share one cache entry; a hit never touches the bytes.
+    return shape_hashed(ts, font, ref.text, ref.len, ref.hash);
+}
+
+const uint8_t *iui_text_atlas(const iui_text_system *ts, uint32_t *width,
+                              uint32_t *height) {
+    if (!ts)
+        return nullptr;
+    if (width)
+        *width = ts->atlas_w;
+    if (height)
+        *height = ts->atlas_h;
+    return ts->atlas.data();
+}
+
+uint32_t iui_text_atlas_version(const iui_text_system *ts) {
+    return ts ? ts->atlas_version : 0;
+}
+
+// --- persistent cache ---------------------------------------------------
+//
+// IUIC layout: header, glyph records (fixed size), the atlas bitmap,
+// then run records (header + quads).  The load path maps the file and
+// restores glyph table, packer cursor and run cache in one pass; after a
+// warm load every piece of static UI text is a cache hit on its first
+// frame and nothing is shaped or rasterized.
+
+namespace {
+
+constexpr uint32_t kCacheMagic = 0x43495549u; /* "IUIC" */
+constexpr uint32_t kCacheVersion = 1;
+
+struct cache_header {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t key; // bundle version + font set, caller-hashed
+    uint32_t atlas_w, atlas_h;
+    uint32_t atlas_version;
+    uint32_t shelf_x, shelf_y, shelf_h;
+    uint32_t font_count;
+    uint32_t glyph_count;
+    uint32_t run_count;
+    uint32_t reserved;
+};
+
+struct cache_glyph {
+    uint64_t key;
+    glyph_entry entry;
+};
+
+struct cache_run {
+    uint64_t text_hash;
+    uint32_t font;
+    uint32_t glyph_count;
+    float width, height;
+    // iui_glyph_quad[glyph_count] follows
+};
+
+} // namespace
+
+iui_status iui_text_cache_save(const iui_text_system *ts, const char *path,
+                               uint64_t key) {
+    if (!ts || !path)
+        return IUI_ERR_INVALID_ARG;
+    FILE *f = fopen(path, "wb");
+    if (!f)
+        return IUI_ERR_IO;
+    cache_header h{};
+    h.magic = kCacheMagic;
+    h.version = kCacheVersion;
+    h.key = key;
+    h.atlas_w = ts->atlas_w;
+    h.atlas_h = ts->atlas_h;
+    h.atlas_version = ts->atlas_version;
+    h.shelf_x = ts->shelf_x;
+    h.shelf_y = ts->shelf_y;
+    h.shelf_h = ts->shelf_h;
+    h.font_count = (uint32_t)ts->fonts.size();
+    h.glyph_count = (uint32_t)ts->glyphs.size();
+    h.run_count = (uint32_t)ts->runs.size();
+    bool ok = fwrite(&h, sizeof(h), 1, f) == 1;
+    for (const auto &g : ts->glyphs) {
+        cache_glyph cg{g.first, g.second};
+        ok = ok && fwrite(&cg, sizeof(cg), 1, f) == 1;
+    }
+    ok = ok && fwrite(ts->atlas.data(), 1, ts->atlas.size(), f) ==
+                   ts->atlas.size();
+    for (const auto &r : ts->runs) {
+        cache_run cr{r.first.text_hash, r.first.font,
+                     (uint32_t)r.second.quads.size(), r.second.run.width,
+                     r.second.run.height};
+        ok = ok && fwrite(&cr, sizeof(cr), 1, f) == 1;
+        ok = ok && (cr.glyph_count == 0 ||
+                    fwrite(r.second.quads.data(), sizeof(iui_glyph_quad),
+                           cr.glyph_count, f) == cr.glyph_count);
+    }
+    if (fclose(f) != 0)
+        ok = false;
+    if (!ok)
+        remove(path); // never leave a short cache behind
+    return ok ? IUI_OK : IUI_ERR_IO;
+}
+
+iui_status iui_text_cache_load(iui_text_system *ts, const char *path,
+                               uint64_t key) {
+    if (!ts || !path)
+        return IUI_ERR_INVALID_ARG;
+    iui::mapped_file file;
+    if (!file.map(path))
+        return IUI_ERR_IO;
+    if (file.size() < sizeof(cache_header))
+        return IUI_ERR_CORRUPT;
+    const cache_header *h = (const cache_header *)file.data();
+    if (h->magic != kCacheMagic || h->version != kCacheVersion)
+        return IUI_ERR_CORRUPT;
+    // A stale cache (new bundle, different fonts, other atlas size) is
+    // expected after an update; the caller falls back to a cold start.
+    if (h->key != key || h->atlas_w != ts->atlas_w ||
+        h->atlas_h != ts->atlas_h || h->font_count != ts->fonts.size())
+        return IUI_ERR_BAD_STATE;
+    uint64_t need = sizeof(cache_header) +
+                    (uint64_t)h->glyph_count * sizeof(cache_glyph) +
+                    (uint64_t)h->atlas_w * h->atlas_h;
+    if (file.size() < need)
+        return IUI_ERR_CORRUPT;
+
+    // Walk every run record before installing anything: the header
+    // contract is that a corrupt cache leaves the system empty but
+    // usable, so ts must not be touched until the whole file has
+    // validated.
+    const uint8_t *p = file.data() + need;
+    const uint8_t *end = file.data() + file.size();
+    for (uint32_t i = 0; i < h->run_count; ++i) {
+        if ((uint64_t)(end - p) < sizeof(cache_run))
+            return IUI_ERR_CORRUPT;
+        cache_run cr;
+        memcpy(&cr, p, sizeof(cr));
+        p += sizeof(cr);
+        if ((uint64_t)(end - p) < (uint64_t)cr.glyph_count *
+                                      sizeof(iui_glyph_quad) ||
+            cr.font == IUI_INVALID_FONT || cr.font >= ts->fonts.size())
+            return IUI_ERR_CORRUPT;
+        p += (size_t)cr.glyph_count * sizeof(iui_glyph_quad);
+    }
+
+    const cache_glyph *glyphs =
+        (const cache_glyph *)(file.data() + sizeof(cache_header));
+    ts->glyphs.reserve(h->glyph_count);
+    for (uint32_t i = 0; i < h->glyph_count; ++i)
+        ts->glyphs.emplace(glyphs[i].key, glyphs[i].entry);
+    memcpy(ts->atlas.data(), glyphs + h->glyph_count, ts->atlas.size());
+    ts->atlas_version = h->atlas_version;
+    ts->shelf_x = h->shelf_x;
+    ts->shelf_y = h->shelf_y;
+    ts->shelf_h = h->shelf_h;
+
+    p = file.data() + need;
+    ts->runs.reserve(h->run_count);
+    for (uint32_t i = 0; i < h->run_count; ++i) {
+        cache_run cr;
+        memcpy(&cr, p, sizeof(cr));
+        p += sizeof(cr);
+        run_entry entry;
+        entry.last_used_frame = ts->frame;
+        entry.quads.resize(cr.glyph_count);
+        memcpy(entry.quads.data(), p,
+               (size_t)cr.glyph_count * sizeof(iui_glyph_quad));
+        p += (size_t)cr.glyph_count * sizeof(iui_glyph_quad);
+        entry.run.glyph_count = cr.glyph_count;
+        entry.run.width = cr.width;
+        entry.run.height = cr.height;
+        auto ins = ts->runs.emplace(run_key{cr.text_hash, cr.font},
+                                    std::move(entry))
+                       .first;
+        ins->second.run.quads = ins->second.quads.data();
+    }
+    iui_startup_mark("text.cache_warm");
+    return IUI_OK;
+}
+
+void iui_text_frame(iui_text_system *ts) {
+    if (!ts)
+        return;
+    ++ts->frame;
+    if (ts->runs.size() <= kRunBudget)
+        return;
+    for (auto it = ts->runs.begin(); it != ts->runs.end();) {
+        if (ts->frame - it->second.last_used_frame > kEvictAge)
+            it = ts->runs.erase(it);
+        else
+            ++it;
+    }
+}
+
+} // extern "C"
@@ -0,0 +1,117 @@
+// theme.cpp — the default theme, specialized at compile time.
+//
+// Styles are composed with constexpr builders: each widget kind defines
+// its base style once and derives the hover/active/disabled variants by
+// transforming it.  The whole table is a constexpr object, so every
+// (kind, state) cell is baked into .rodata by the compiler — at runtime
+// there is no construction, no locking, and resolution is a plain array
+// index.
+
+#include "iui/theme.h"
+
+#include "context.h"
+
+#include <type_traits>
+
+namespace {
+
+// Scale the RGB channels of an 0xAABBGGRR color, alpha untouched.
+constexpr uint32_t shade(uint32_t color, int percent) {
+    uint32_t out = color & 0xff000000u;
+    for (int shift = 0; shift < 24; shift += 8) {
+        uint32_t c = (color >> shift) & 0xffu;
+        c = (uint32_t)((int)c * percent / 100);
+        out |= (c > 0xffu ? 0xffu : c) << shift;
+    }
+    return out;
+}
+
+constexpr iui_style hover(iui_style s) {
+    s.bg_color = shade(s.bg_color, 115);
+    s.border_color = shade(s.border_color, 125);
+    return s;
+}
+
+constexpr iui_style active(iui_style s) {
+    s.bg_color = shade(s.bg_color, 85);
+    s.border_color = shade(s.border_color, 140);
+    return s;
+}
+
+constexpr iui_style disabled(iui_style s) {
+    s.bg_color = shade(s.bg_color, 60);
+    s.fg_color = (s.fg_color & 0x00ffffffu) | 0x60000000u;
+    s.border_color = shade(s.border_color, 60);
+    return s;
+}
+
+// One row of the table: the base style plus its derived states.
+constexpr void fill_kind(iui_theme &t, iui_widget_kind kind, iui_style base) {
+    t.styles[kind][IUI_STATE_NORMAL] = base;
+    t.styles[kind][IUI_STATE_HOVER] = hover(base);
+    t.styles[kind][IUI_STATE_ACTIVE] = active(base);
+    t.styles[kind][IUI_STATE_DISABLED] = disabled(base);
+}
+
+constexpr iui_theme make_default_theme() {
+    iui_theme t{};
+    fill_kind(t, IUI_KIND_PANEL,
+              iui_style{0xff262626u, 0xffe8e8e8u, 0xff3a3a3au,
+                        1.0f, 4.0f, 8.0f, 4.0f, 0});
+    fill_kind(t, IUI_KIND_BUTTON,
+              iui_style{0xff3d3d3du, 0xfff2f2f2u, 0xff575757u,
+                        1.0f, 4.0f, 6.0f, 0.0f, 0});
+    fill_kind(t, IUI_KIND_LABEL,
+              iui_style{0x00000000u, 0xffd8d8d8u, 0x00000000u,
+                        0.0f, 0.0f, 2.0f, 0.0f, 0});
+    fill_kind(t, IUI_KIND_INPUT,
+              iui_style{0xff1c1c1cu, 0xfff2f2f2u, 0xff4a4a4au,
+                        1.0f, 3.0f, 6.0f, 0.0f, 0});
+    fill_kind(t, IUI_KIND_LIST_ROW,
+              iui_style{0xff2b2b2bu, 0xffdededeu, 0x00000000u,
+                        0.0f, 0.0f, 6.0f, 2.0f, 0});
+    fill_kind(t, IUI_KIND_SCROLLBAR,
+              iui_style{0xff4f4f4fu, 0xff9a9a9au, 0x00000000u,
+                        0.0f, 3.0f, 0.0f, 0.0f, 0});
+    return t;
+}
+
+constexpr iui_theme k_default_theme = make_default_theme();
+
+// The table must stay a plain array of plain structs, or direct FFI
+// indexing from Lua silently reads garbage.
+static_assert(std::is_trivially_copyable<iui_theme>::value,
+              "theme must be POD for FFI");
+static_assert(sizeof(iui_theme) ==
+                  sizeof(iui_style) * IUI_KIND_COUNT * IUI_STATE_COUNT,
+              "theme table must be densely packed");
+
+} // namespace
+
+extern "C" {
+
+const iui_theme *iui_theme_default(void) {
+    return &k_default_theme;
+}
+
+void iui_context_set_theme(iui_context *ctx, const iui_theme *t) {
+    if (ctx)
+        ctx->theme = t ? t : &k_default_theme;
+}
+
+const iui_theme *iui_context_theme(const iui_context *ctx) {
+    return ctx ? ctx->theme : &k_default_theme;
+}
+
+const iui_style *iui_style_resolve(const iui_context *ctx,
+                                   iui_widget_kind kind,
+                                   iui_widget_state state) {
+    const iui_theme *t = ctx ? ctx->theme : &k_default_theme;
+    if ((unsigned)kind >= IUI_KIND_COUNT)
+        kind = IUI_KIND_PANEL;
+    if ((unsigned)state >= IUI_STATE_COUNT)
+        state = IUI_STATE_NORMAL;
+    return &t->styles[kind][state];
+}
+
+} // extern "C"
@@ -0,0 +1,208 @@
+// trace.cpp — zero-copy reader and streaming writer for IUIT traces.
+
+#include "iui/trace.h"
+
+#include "mapped_file.h"
+#include "task_pool.h"
+
+#include <cstdio>
+#include <new>
+#include <vector>
+
+struct iui_trace_reader {
+    iui::mapped_file file;
+    uint64_t cursor = 0; // byte offset of the next record's length prefix
+    uint64_t read_count = 0;
+};
+
+struct iui_trace_frames {
+    // Decoded event pointers (into the reader's mapping), flat in capture
+    // order; frame f owns [first[f], first[f + 1]).  Frame marks are not
+    // included in any batch.
+    std::vector<const iui_event *> events;
+    std::vector<uint64_t> first;
+};
+
+struct iui_trace_writer {
+    FILE *out = nullptr;
+    uint64_t record_count = 0;
+};
+
+namespace {
+
+const iui_trace_header *header(const iui_trace_reader *r) {
+    return (const iui_trace_header *)r->file.data();
+}
+
+} // namespace
+
+extern "C" {
+
+iui_trace_reader *iui_trace_open(const char *path) {
+    if (!path)
+        return nullptr;
+    iui_trace_reader *r = new (std::nothrow) iui_trace_reader();
+    if (!r)
+        return nullptr;
+    if (!r->file.map(path) || r->file.size() < sizeof(iui_trace_header)) {
+        delete r;
+        return nullptr;
+    }
+    const iui_trace_header *h = header(r);
+    if (h->magic != IUI_TRACE_MAGIC || h->version != IUI_TRACE_VERSION) {
+        delete r;
+        return nullptr;
+    }
+    r->cursor = sizeof(iui_trace_header);
+    return r;
+}
+
+void iui_trace_close(iui_trace_reader *r) {
+    delete r;
+}
+
+uint64_t iui_trace_count(const iui_trace_reader *r) {
+    return r ? header(r)->record_count : 0;
+}
+
+const iui_event *iui_trace_next(iui_trace_reader *r) {
+    if (!r || r->read_count >= header(r)->record_count)
+        return nullptr;
+    uint64_t remaining = r->file.size() - r->cursor;
+    if (remaining < sizeof(uint32_t))
+        return nullptr;
+    uint32_t size = *(const uint32_t *)(r->file.data() + r->cursor);
+    if (size < sizeof(iui_event) || remaining - sizeof(uint32_t) < size)
+        return nullptr; // truncated or corrupt tail
+    const iui_event *e =
+        (const iui_event *)(r->file.data() + r->cursor + sizeof(uint32_t));
+    r->cursor += sizeof(uint32_t) + size;
+    ++r->read_count;
+    return e;
+}
+
+void iui_trace_rewind(iui_trace_reader *r) {
+    if (!r)
+        return;
+    r->cursor = sizeof(iui_trace_header);
+    r->read_count = 0;
+}
+
+iui_trace_frames *iui_trace_frames_build(iui_trace_reader *r) {
+    if (!r)
+        return nullptr;
+    iui_trace_frames *f = new (std::nothrow) iui_trace_frames();
+    if (!f)
+        return nullptr;
+
+    // Pass 1, sequential: hop the length prefixes to find every record's
+    // offset and the frame-mark boundaries.  Only 4 bytes are touched per
+    // record, so this runs at disk speed even on multi-gigabyte traces.
+    std::vector<uint64_t> offsets;
+    offsets.reserve(header(r)->record_count);
+    std::vector<std::pair<uint64_t, uint64_t>> shards; // record index ranges
+    const uint8_t *base = r->file.data();
+    uint64_t cursor = sizeof(iui_trace_header);
+    uint64_t frame_begin = 0;
+    for (uint64_t i = 0; i < header(r)->record_count; ++i) {
+        uint64_t remaining = r->file.size() - cursor;
+        if (remaining < sizeof(uint32_t))
+            break;
+        uint32_t size = *(const uint32_t *)(base + cursor);
+        if (size < sizeof(iui_event) || remaining - sizeof(uint32_t) < size)
+            break; // truncated or corrupt tail
+        uint32_t type = *(const uint32_t *)(base + cursor + sizeof(uint32_t));
+        if (type == IUI_EVENT_FRAME_MARK) {
+            shards.emplace_back(frame_begin, offsets.size());
+            frame_begin = offsets.size();
+        } else {
+            offsets.push_back(cursor);
+        }
+        cursor += sizeof(uint32_t) + size;
+    }
+    if (frame_begin < offsets.size())
+        shards.emplace_back(frame_begin, offsets.size()); // unterminated tail
+
+    // Pass 2, parallel: decode each shard into its slice of the flat
+    // pointer array.  Shards write disjoint ranges, so no synchronization
+    // is needed; item stealing on the pool balances uneven frames.  For
+    // the fixed v1 record this is pointer setup; payload parsing for
+    // future versions belongs here, off the consuming thread.
+    f->events.resize(offsets.size());
+    f->first.resize(shards.size() + 1);
+    for (size_t s = 0; s < shards.size(); ++s)
+        f->first[s] = shards[s].first;
+    f->first[shards.size()] = offsets.size();
+    iui::task_pool::instance().parallel_for(shards.size(), [&](size_t s) {
+        for (uint64_t i = shards[s].first; i < shards[s].second; ++i)
+            f->events[i] =
+                (const iui_event *)(base + offsets[i] + sizeof(uint32_t));
+    });
+    return f;
+}
+
+void iui_trace_frames_destroy(iui_trace_frames *f) {
+    delete f;
+}
+
+uint64_t iui_trace_frames_count(const iui_trace_frames *f) {
+    return f && !f->first.empty() ? f->first.size() - 1 : 0;
+}
+
+const iui_event *const *iui_trace_frames_events(const iui_trace_frames *f,
+                                                uint64_t frame,
+                                                uint32_t *count_out) {
+    if (!f || frame + 1 >= f->first.size()) {
+        if (count_out)
+            *count_out = 0;
+        return nullptr;
+    }
+    if (count_out)
+        *count_out = (uint32_t)(f->first[frame + 1] - f->first[frame]);
+    return f->events.data() + f->first[frame];
+}
+
+iui_trace_writer *iui_trace_writer_open(const char *path) {
+    if (!path)
+        return nullptr;
+    FILE *out = fopen(path, "wb");
+    if (!out)
+        return nullptr;
+    iui_trace_writer *w = new (std::nothrow) iui_trace_writer();
+    if (!w) {
+        fclose(out);
+        return nullptr;
+    }
+    w->out = out;
+    // Placeholder header; record_count is patched in on close.
+    iui_trace_header h{IUI_TRACE_MAGIC, IUI_TRACE_VERSION, 0};
+    fwrite(&h, sizeof(h), 1, out);
+    return w;
+}
+
+iui_status iui_trace_write(iui_trace_writer *w, const iui_event *e) {
+    if (!w || !e)
+        return IUI_ERR_INVALID_ARG;
+    uint32_t size = sizeof(iui_event);
+    if (fwrite(&size, sizeof(size), 1, w->out) != 1 ||
+        fwrite(e, sizeof(iui_event), 1, w->out) != 1)
+        return IUI_ERR_IO;
+    ++w->record_count;
+    return IUI_OK;
+}
+
+iui_status iui_trace_writer_close(iui_trace_writer *w) {
+    if (!w)
+        return IUI_ERR_INVALID_ARG;
+    iui_trace_header h{IUI_TRACE_MAGIC, IUI_TRACE_VERSION, w->record_count};
+    iui_status st = IUI_OK;
+    if (fseek(w->out, 0, SEEK_SET) != 0 ||
+        fwrite(&h, sizeof(h), 1, w->out) != 1)
+        st = IUI_ERR_IO;
+    if (fclose(w->out) != 0)
+        st = IUI_ERR_IO;
+    delete w;
+    return st;
+}
+
+} // extern "C"
@@ -0,0 +1,117 @@
+// virtual_list.cpp — windowed materialization over the stacking layout.
+//
+// The pane is an ordinary column widget; a leading spacer the height of
+// all rows above the window puts the materialized rows at their true
+// virtual position (the pane's scroll offset then shifts them per pixel),
+// and a trailing spacer restores the full content extent for FIT parents
+// and scrollbar math.  No layout-engine special case needed.
+
+#include "iui/list.h"
+
+#include "context.h"
+
+#include <cinttypes>
+#include <cmath>
+#include <cstdio>
+
+namespace {
+
+// Per-pane bookkeeping between list_begin and list_end, kept on a small
+// stack so lists can nest (a table inside a virtualized panel).
+struct list_frame {
+    uint64_t total_rows;
+    float row_height;
+    uint64_t first_row;
+    uint32_t row_count;
+};
+
+// Declaration is single-threaded per context; a per-thread stack keeps
+// this file free of context-struct churn for a purely local concern.
+thread_local std::vector<list_frame> t_list_stack;
+
+} // namespace
+
+extern "C" {
+
+iui_status iui_list_begin(iui_context *ctx, const char *id,
+                          uint64_t total_rows, float row_height,
+                          uint32_t margin_rows, iui_list_info *out) {
+    if (!ctx || !id || row_height <= 0.0f || !out)
+        return IUI_ERR_INVALID_ARG;
+    iui_widget pane = iui_widget_begin(ctx, id);
+    if (pane == IUI_INVALID_WIDGET)
+        return IUI_ERR_BAD_STATE;
+    iui_widget_set_axis(ctx, IUI_AXIS_COLUMN);
+
+    iui_slot slot = iui_widget_slot(ctx);
+    // Viewport height and scroll as of the previous frame.
+    float pane_h = ctx->store.bounds[slot].h;
+    float content_h = (float)total_rows * row_height;
+    float max_scroll = content_h > pane_h ? content_h - pane_h : 0.0f;
+    float scroll = ctx->store.scroll_y[slot];
+    if (scroll > max_scroll)
+        ctx->store.scroll_y[slot] = scroll = max_scroll;
+    if (scroll < 0.0f)
+        ctx->store.scroll_y[slot] = scroll = 0.0f;
+
+    float margin_px = (float)margin_rows * row_height;
+    uint64_t first = 0;
+    if (scroll > margin_px)
+        first = (uint64_t)((scroll - margin_px) / row_height);
+    uint64_t visible =
+        (uint64_t)std::ceil((pane_h + 2.0f * margin_px) / row_height) + 1;
+    if (first > total_rows)
+        first = total_rows;
+    uint64_t count =
+        first + visible <= total_rows ? visible : total_rows - first;
+
+    // Leading spacer: the rows above the window, collapsed into one node.
+    if (first > 0) {
+        iui_widget_begin(ctx, "~lead");
+        iui_widget_set_size(ctx, IUI_SIZE_FILL, (float)first * row_height);
+        iui_widget_end(ctx);
+    }
+
+    t_list_stack.push_back(
+        list_frame{total_rows, row_height, first, (uint32_t)count});
+    out->first_row = first;
+    out->row_count = (uint32_t)count;
+    out->slot = slot;
+    out->max_scroll = max_scroll;
+    return IUI_OK;
+}
+
+iui_status iui_list_row_begin(iui_context *ctx, uint64_t row) {
+    if (!ctx || t_list_stack.empty())
+        return IUI_ERR_BAD_STATE;
+    const list_frame &lf = t_list_stack.back();
+    if (row < lf.first_row || row >= lf.first_row + lf.row_count)
+        return IUI_ERR_INVALID_ARG;
+    char id[24];
+    snprintf(id, sizeof(id), "r%" PRIu64, row);
+    if (iui_widget_begin(ctx, id) == IUI_INVALID_WIDGET)
+        return IUI_ERR_BAD_STATE;
+    iui_widget_set_size(ctx, IUI_SIZE_FILL, lf.row_height);
+    return IUI_OK;
+}
+
+iui_status iui_list_row_end(iui_context *ctx) {
+    return iui_widget_end(ctx);
+}
+
+iui_status iui_list_end(iui_context *ctx) {
+    if (!ctx || t_list_stack.empty())
+        return IUI_ERR_BAD_STATE;
+    list_frame lf = t_list_stack.back();
+    t_list_stack.pop_back();
+    uint64_t below = lf.total_rows - lf.first_row - lf.row_count;
+    if (below > 0) {
+        iui_widget_begin(ctx, "~tail");
+        iui_widget_set_size(ctx, IUI_SIZE_FILL,
+                            (float)below * lf.row_height);
+        iui_widget_end(ctx);
+    }
+    return iui_widget_end(ctx);
+}
+
+} // extern "C"
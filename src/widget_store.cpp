@@ -0,0 +1,101 @@
+// widget_store.cpp — slot allocation, recycling and the store C API.
+
+#include "widget_store.h"
+
+#include "context.h"
+#include "iui/store.h"
+
+namespace iui {
+
+uint32_t widget_store::acquire(uint64_t path_hash) {
+    auto it = by_path_.find(path_hash);
+    if (it != by_path_.end()) {
+        last_frame_[it->second] = frame_;
+        return it->second;
+    }
+    uint32_t slot;
+    if (!free_.empty()) {
+        slot = free_.back();
+        free_.pop_back();
+        path_[slot] = path_hash;
+        last_frame_[slot] = frame_;
+        bounds[slot] = iui_rect{};
+        scroll_x[slot] = scroll_y[slot] = 0.0f;
+        anim[slot] = 0.0f;
+    } else {
+        slot = (uint32_t)path_.size();
+        path_.push_back(path_hash);
+        last_frame_.push_back(frame_);
+        bounds.push_back(iui_rect{});
+        scroll_x.push_back(0.0f);
+        scroll_y.push_back(0.0f);
+        anim.push_back(0.0f);
+    }
+    by_path_[path_hash] = slot;
+    return slot;
+}
+
+void widget_store::begin_frame() {
+    ++frame_;
+    // Amortized recycling: scan a slice of the columns per frame so no
+    // frame pays for the whole sweep.
+    if (path_.empty())
+        return;
+    uint32_t n = size();
+    uint32_t begin = (frame_ * 257u) % n;
+    uint32_t len = n / 64 + 1;
+    for (uint32_t i = 0; i < len; ++i) {
+        uint32_t slot = (begin + i) % n;
+        if (path_[slot] && frame_ - last_frame_[slot] > kRecycleAge) {
+            by_path_.erase(path_[slot]);
+            path_[slot] = 0;
+            free_.push_back(slot);
+        }
+    }
+}
+
+} // namespace iui
+
+extern "C" {
+
+iui_slot iui_widget_slot(const iui_context *ctx) {
+    if (!ctx || !ctx->in_frame || ctx->current_parent <= 1)
+        return IUI_INVALID_SLOT;
+    return ctx->nodes[ctx->current_parent].slot;
+}
+
+iui_slot iui_slot_of(const iui_context *ctx, iui_widget w) {
+    if (!ctx || w == 0 || w >= ctx->nodes.size())
+        return IUI_INVALID_SLOT;
+    return ctx->nodes[w].slot;
+}
+
+uint32_t iui_store_size(const iui_context *ctx) {
+    return ctx ? ctx->store.size() : 0;
+}
+
+const iui_rect *iui_store_bounds(const iui_context *ctx) {
+    return ctx ? ctx->store.bounds.data() : nullptr;
+}
+
+iui_status iui_slot_set_scroll(iui_context *ctx, iui_slot slot, float x,
+                               float y) {
+    if (!ctx || slot >= ctx->store.size())
+        return IUI_ERR_INVALID_ARG;
+    ctx->store.scroll_x[slot] = x;
+    ctx->store.scroll_y[slot] = y;
+    return IUI_OK;
+}
+
+iui_status iui_slot_get_scroll(const iui_context *ctx, iui_slot slot,
+                               float *x, float *y) {
+    if (!ctx || slot >= ctx->store.size())
+        return IUI_ERR_INVALID_ARG;
+    if (x)
+        *x = ctx->store.scroll_x[slot];
+    if (y)
+        *y = ctx->store.scroll_y[slot];
+    return IUI_OK;
+}
+
+} // extern "C"
@@ -0,0 +1,46 @@
+// widget_store.h — internal SoA columns behind include/iui/store.h.
+//
+// One growable column per field; slot 0..size-1.  The path→slot map is the
+// only hashed structure; everything downstream of widget_begin works in
+// flat arrays.
+#ifndef IUI_SRC_WIDGET_STORE_H
+#define IUI_SRC_WIDGET_STORE_H
+
+#include "iui/iui.h"
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace iui {
+
+class widget_store {
+  public:
+    // Slot for this path, creating or resurrecting one as needed, and
+    // stamps it live for the current frame.
+    uint32_t acquire(uint64_t path_hash);
+
+    void begin_frame();
+
+    uint32_t size() const { return (uint32_t)path_.size(); }
+
+    // Hot columns, index = slot.
+    std::vector<iui_rect> bounds;
+    std::vector<float> scroll_x;
+    std::vector<float> scroll_y;
+    std::vector<float> anim; // animation scratch, one lane per slot
+
+  private:
+    // Slots idle this many frames get recycled.
+    static constexpr uint32_t kRecycleAge = 600;
+
+    std::vector<uint64_t> path_;       // identity column
+    std::vector<uint32_t> last_frame_; // liveness stamp
+    std::unordered_map<uint64_t, uint32_t> by_path_;
+    std::vector<uint32_t> free_;
+    uint32_t frame_ = 0;
+};
+
+} // namespace iui
+
+#endif // IUI_SRC_WIDGET_STORE_H
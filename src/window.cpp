@@ -0,0 +1,183 @@
+// window.cpp — per-window present threads behind iui_window_set.
+//
+// Each window owns a context and, once a present callback is installed,
+// a thread parked on the set's condition variable.  A kick bumps the
+// shared frame sequence and notifies; each thread presents when its own
+// presented counter is behind the sequence.  A thread that wakes several
+// kicks late presents once and jumps its counter to the current
+// sequence — that is the frame-dropping that keeps a 30 Hz display from
+// stalling a 60 Hz declaration loop.  The set mutex only guards the
+// counters and sleep/wake; present callbacks run outside it, so slow
+// swapchains never serialize against each other.
+
+#include "iui/window.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <vector>
+
+struct iui_window_set {
+    struct window {
+        iui_context *ctx = nullptr;
+        float width = 0.0f;
+        float height = 0.0f;
+        iui_present_fn present = nullptr;
+        void *user = nullptr;
+        std::thread thread;
+        uint64_t presented = 0;
+        bool stop = false;
+    };
+
+    std::vector<window *> windows;
+    std::mutex mutex;
+    std::condition_variable kick_cv;
+    std::condition_variable done_cv;
+    uint64_t frame_seq = 0;
+};
+
+namespace {
+
+void present_loop(iui_window_set *ws, uint32_t index) {
+    iui_window_set::window *w = ws->windows[index];
+    std::unique_lock<std::mutex> lock(ws->mutex);
+    for (;;) {
+        ws->kick_cv.wait(lock, [&] {
+            return w->stop || w->presented < ws->frame_seq;
+        });
+        if (w->stop)
+            return;
+        uint64_t target = ws->frame_seq;
+        lock.unlock();
+        w->present((iui_window)index, w->ctx, w->user);
+        lock.lock();
+        w->presented = target; // kicks missed while presenting are dropped
+        ws->done_cv.notify_all();
+    }
+}
+
+void stop_thread(iui_window_set *ws, iui_window_set::window *w) {
+    {
+        std::lock_guard<std::mutex> lock(ws->mutex);
+        w->stop = true;
+    }
+    ws->kick_cv.notify_all();
+    if (w->thread.joinable())
+        w->thread.join();
+    w->stop = false;
+}
+
+} // namespace
+
+extern "C" {
+
+iui_window_set *iui_window_set_create(void) {
+    return new (std::nothrow) iui_window_set();
+}
+
+void iui_window_set_destroy(iui_window_set *ws) {
+    if (!ws)
+        return;
+    for (iui_window_set::window *w : ws->windows) {
+        stop_thread(ws, w);
+        iui_context_destroy(w->ctx);
+        delete w;
+    }
+    delete ws;
+}
+
+iui_window iui_window_add(iui_window_set *ws, float width, float height) {
+    if (!ws || width <= 0.0f || height <= 0.0f)
+        return IUI_INVALID_WINDOW;
+    iui_window_set::window *w = new (std::nothrow) iui_window_set::window();
+    if (!w)
+        return IUI_INVALID_WINDOW;
+    w->ctx = iui_context_create();
+    if (!w->ctx) {
+        delete w;
+        return IUI_INVALID_WINDOW;
+    }
+    w->width = width;
+    w->height = height;
+    w->presented = ws->frame_seq; // no catch-up presents for late windows
+    ws->windows.push_back(w);
+    return (iui_window)(ws->windows.size() - 1);
+}
+
+iui_status iui_window_resize(iui_window_set *ws, iui_window win, float width,
+                             float height) {
+    if (!ws || win >= ws->windows.size() || width <= 0.0f || height <= 0.0f)
+        return IUI_ERR_INVALID_ARG;
+    ws->windows[win]->width = width;
+    ws->windows[win]->height = height;
+    return IUI_OK;
+}
+
+iui_context *iui_window_context(iui_window_set *ws, iui_window win) {
+    if (!ws || win >= ws->windows.size())
+        return nullptr;
+    return ws->windows[win]->ctx;
+}
+
+iui_status iui_window_size(const iui_window_set *ws, iui_window win,
+                           float *width, float *height) {
+    if (!ws || win >= ws->windows.size())
+        return IUI_ERR_INVALID_ARG;
+    if (width)
+        *width = ws->windows[win]->width;
+    if (height)
+        *height = ws->windows[win]->height;
+    return IUI_OK;
+}
+
+iui_status iui_window_set_present(iui_window_set *ws, iui_window win,
+                                  iui_present_fn fn, void *user) {
+    if (!ws || win >= ws->windows.size())
+        return IUI_ERR_INVALID_ARG;
+    iui_window_set::window *w = ws->windows[win];
+    if (w->present)
+        stop_thread(ws, w);
+    w->present = fn;
+    w->user = user;
+    if (fn) {
+        {
+            std::lock_guard<std::mutex> lock(ws->mutex);
+            w->presented = ws->frame_seq;
+        }
+        w->thread = std::thread(present_loop, ws, win);
+    }
+    return IUI_OK;
+}
+
+void iui_window_set_kick(iui_window_set *ws) {
+    if (!ws)
+        return;
+    {
+        std::lock_guard<std::mutex> lock(ws->mutex);
+        ++ws->frame_seq;
+    }
+    ws->kick_cv.notify_all();
+}
+
+void iui_window_set_wait(iui_window_set *ws) {
+    if (!ws)
+        return;
+    std::unique_lock<std::mutex> lock(ws->mutex);
+    ws->done_cv.wait(lock, [&] {
+        for (const iui_window_set::window *w : ws->windows)
+            if (w->present && w->presented < ws->frame_seq)
+                return false;
+        return true;
+    });
+}
+
+uint64_t iui_window_presented(const iui_window_set *ws, iui_window win) {
+    if (!ws || win >= ws->windows.size())
+        return 0;
+    std::lock_guard<std::mutex> lock(
+        const_cast<iui_window_set *>(ws)->mutex);
+    return ws->windows[win]->presented;
+}
+
+} // extern "C"
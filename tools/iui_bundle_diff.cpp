@@ -0,0 +1,209 @@
+// iui_bundle_diff — create and apply content-defined-chunking patches.
+//
+// Usage: iui_bundle_diff diff <old> <new> <out.iuip>
+//        iui_bundle_diff apply <old> <patch.iuip> <out>
+//
+// Both files are cut into chunks at gear-hash boundaries; chunks of the
+// new file that already exist anywhere in the old file become copy
+// records, everything else ships inline.  Adjacent records of the same
+// kind are merged, so an unchanged multi-megabyte luajit.exe collapses to
+// a single copy record.
+
+#include "iui/patch.h"
+
+#include <cstdio>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+// Same strong hash the apply path verifies against (FNV-1a).
+uint64_t fnv1a(const uint8_t *data, uint64_t size) {
+    uint64_t h = 1469598103934665603ull;
+    for (uint64_t i = 0; i < size; ++i) {
+        h ^= data[i];
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+// Gear table: any fixed pseudo-random permutation works; generated from a
+// splitmix64 sequence so diff output is stable across builds.
+uint64_t gear_table[256];
+
+void init_gear() {
+    uint64_t x = 0x2545f4914f6cdd1dull;
+    for (int i = 0; i < 256; ++i) {
+        x += 0x9e3779b97f4a7c15ull;
+        uint64_t z = x;
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        gear_table[i] = z ^ (z >> 31);
+    }
+}
+
+struct chunk {
+    uint64_t offset;
+    uint64_t length;
+    uint64_t hash; // strong hash of the chunk bytes
+};
+
+std::vector<chunk> chunk_file(const uint8_t *data, uint64_t size) {
+    std::vector<chunk> chunks;
+    uint64_t start = 0;
+    uint64_t gear = 0;
+    for (uint64_t i = 0; i < size; ++i) {
+        gear = (gear << 1) + gear_table[data[i]];
+        uint64_t len = i + 1 - start;
+        if ((len >= IUI_CDC_MIN_CHUNK && (gear & IUI_CDC_AVG_MASK) == 0) ||
+            len >= IUI_CDC_MAX_CHUNK) {
+            chunks.push_back(
+                chunk{start, len, fnv1a(data + start, len)});
+            start = i + 1;
+            gear = 0;
+        }
+    }
+    if (start < size)
+        chunks.push_back(
+            chunk{start, size - start, fnv1a(data + start, size - start)});
+    return chunks;
+}
+
+bool read_file(const char *path, std::vector<uint8_t> &out) {
+    FILE *f = fopen(path, "rb");
+    if (!f)
+        return false;
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    if (size < 0) {
+        fclose(f);
+        return false;
+    }
+    out.resize((size_t)size);
+    bool ok = size == 0 || fread(out.data(), 1, (size_t)size, f) == (size_t)size;
+    fclose(f);
+    return ok;
+}
+
+int make_diff(const char *old_path, const char *new_path,
+              const char *out_path) {
+    std::vector<uint8_t> old_data, new_data;
+    if (!read_file(old_path, old_data) || !read_file(new_path, new_data)) {
+        fprintf(stderr, "error: cannot read input files\n");
+        return 1;
+    }
+    init_gear();
+
+    // Index old chunks by strong hash; collisions resolved by memcmp.
+    std::vector<chunk> old_chunks =
+        chunk_file(old_data.data(), old_data.size());
+    std::unordered_multimap<uint64_t, const chunk *> index;
+    index.reserve(old_chunks.size());
+    for (const chunk &c : old_chunks)
+        index.emplace(c.hash, &c);
+
+    std::vector<iui_patch_record> records;
+    std::vector<uint8_t> literals;
+    uint64_t pending_insert_start = 0, pending_insert_len = 0;
+
+    auto flush_insert = [&](uint64_t end_excl) {
+        (void)end_excl;
+        if (!pending_insert_len)
+            return;
+        iui_patch_record rec{};
+        rec.op = IUI_PATCH_INSERT;
+        rec.length = pending_insert_len;
+        records.push_back(rec);
+        literals.insert(literals.end(),
+                        new_data.begin() + (long)pending_insert_start,
+                        new_data.begin() +
+                            (long)(pending_insert_start + pending_insert_len));
+        pending_insert_len = 0;
+    };
+
+    for (const chunk &c : chunk_file(new_data.data(), new_data.size())) {
+        const chunk *match = nullptr;
+        auto range = index.equal_range(c.hash);
+        for (auto it = range.first; it != range.second; ++it) {
+            if (it->second->length == c.length &&
+                memcmp(old_data.data() + it->second->offset,
+                       new_data.data() + c.offset, c.length) == 0) {
+                match = it->second;
+                break;
+            }
+        }
+        if (match) {
+            flush_insert(c.offset);
+            // Merge with a preceding contiguous copy.
+            if (!records.empty() && records.back().op == IUI_PATCH_COPY &&
+                records.back().offset + records.back().length ==
+                    match->offset) {
+                records.back().length += c.length;
+            } else {
+                iui_patch_record rec{};
+                rec.op = IUI_PATCH_COPY;
+                rec.offset = match->offset;
+                rec.length = c.length;
+                records.push_back(rec);
+            }
+        } else {
+            if (!pending_insert_len)
+                pending_insert_start = c.offset;
+            pending_insert_len += c.length;
+        }
+    }
+    flush_insert(new_data.size());
+
+    iui_patch_header header{};
+    header.magic = IUI_PATCH_MAGIC;
+    header.version = IUI_PATCH_VERSION;
+    header.record_count = records.size();
+    header.new_size = new_data.size();
+    header.new_hash = fnv1a(new_data.data(), new_data.size());
+
+    FILE *out = fopen(out_path, "wb");
+    if (!out) {
+        fprintf(stderr, "error: cannot write %s\n", out_path);
+        return 1;
+    }
+    fwrite(&header, sizeof(header), 1, out);
+    const uint8_t *lit = literals.data();
+    for (const iui_patch_record &rec : records) {
+        fwrite(&rec, sizeof(rec), 1, out);
+        if (rec.op == IUI_PATCH_INSERT) {
+            fwrite(lit, 1, rec.length, out);
+            lit += rec.length;
+        }
+    }
+    long patch_size = ftell(out);
+    fclose(out);
+
+    printf("%s: %zu records, %llu literal bytes, patch %ld bytes "
+           "(new file %zu bytes)\n",
+           out_path, records.size(), (unsigned long long)literals.size(),
+           patch_size, new_data.size());
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    if (argc == 5 && strcmp(argv[1], "diff") == 0)
+        return make_diff(argv[2], argv[3], argv[4]);
+    if (argc == 5 && strcmp(argv[1], "apply") == 0) {
+        iui_status st = iui_patch_apply(argv[2], argv[3], argv[4]);
+        if (st != IUI_OK) {
+            fprintf(stderr, "error: patch apply failed (%d)\n", (int)st);
+            return 1;
+        }
+        printf("%s: patched successfully\n", argv[4]);
+        return 0;
+    }
+    fprintf(stderr,
+            "usage: %s diff <old> <new> <out.iuip>\n"
+            "       %s apply <old> <patch.iuip> <out>\n",
+            argv[0], argv[0]);
+    return 2;
+}
@@ -0,0 +1,111 @@
+// iui_bundle_pack — build an IUIB bundle from a list of files.
+//
+// Usage: iui_bundle_pack <out.iuib> <file>...
+//
+// Each input file becomes an entry named by its basename, payload aligned
+// to IUI_BUNDLE_PAGE so the launcher can map the bundle and hand entries
+// straight to the loader.
+
+#include "iui/bundle.h"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::string basename_of(const std::string &path) {
+    size_t slash = path.find_last_of("/\\");
+    return slash == std::string::npos ? path : path.substr(slash + 1);
+}
+
+bool read_file(const char *path, std::vector<uint8_t> &out) {
+    FILE *f = fopen(path, "rb");
+    if (!f)
+        return false;
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    if (size < 0) {
+        fclose(f);
+        return false;
+    }
+    out.resize((size_t)size);
+    bool ok = size == 0 || fread(out.data(), 1, (size_t)size, f) == (size_t)size;
+    fclose(f);
+    return ok;
+}
+
+uint64_t align_page(uint64_t v) {
+    return (v + IUI_BUNDLE_PAGE - 1) & ~(uint64_t)(IUI_BUNDLE_PAGE - 1);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    if (argc < 3) {
+        fprintf(stderr, "usage: %s <out.iuib> <file>...\n", argv[0]);
+        return 2;
+    }
+    const char *out_path = argv[1];
+    uint32_t count = (uint32_t)(argc - 2);
+
+    std::vector<std::string> names;
+    std::vector<std::vector<uint8_t>> payloads(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        if (!read_file(argv[2 + i], payloads[i])) {
+            fprintf(stderr, "error: cannot read %s\n", argv[2 + i]);
+            return 1;
+        }
+        names.push_back(basename_of(argv[2 + i]));
+    }
+
+    // Lay out: header, entry table, name blob, then page-aligned payloads.
+    std::vector<iui_bundle_entry> entries(count);
+    uint64_t name_base =
+        sizeof(iui_bundle_header) + (uint64_t)count * sizeof(iui_bundle_entry);
+    uint64_t cursor = name_base;
+    for (uint32_t i = 0; i < count; ++i) {
+        entries[i].name_offset = cursor;
+        cursor += names[i].size() + 1;
+    }
+    for (uint32_t i = 0; i < count; ++i) {
+        cursor = align_page(cursor);
+        entries[i].data_offset = cursor;
+        entries[i].size = payloads[i].size();
+        entries[i].reserved = 0;
+        cursor += payloads[i].size();
+    }
+
+    iui_bundle_header header{};
+    header.magic = IUI_BUNDLE_MAGIC;
+    header.version = IUI_BUNDLE_VERSION;
+    header.entry_count = count;
+    header.file_size = cursor;
+
+    FILE *out = fopen(out_path, "wb");
+    if (!out) {
+        fprintf(stderr, "error: cannot open %s for writing\n", out_path);
+        return 1;
+    }
+    fwrite(&header, sizeof(header), 1, out);
+    fwrite(entries.data(), sizeof(iui_bundle_entry), count, out);
+    uint64_t written = name_base;
+    for (uint32_t i = 0; i < count; ++i) {
+        fwrite(names[i].c_str(), 1, names[i].size() + 1, out);
+        written += names[i].size() + 1;
+    }
+    for (uint32_t i = 0; i < count; ++i) {
+        uint64_t aligned = align_page(written);
+        for (; written < aligned; ++written)
+            fputc(0, out);
+        fwrite(payloads[i].data(), 1, payloads[i].size(), out);
+        written += payloads[i].size();
+    }
+    fclose(out);
+
+    printf("%s: %u entries, %llu bytes\n", out_path, count,
+           (unsigned long long)written);
+    return 0;
+}
@@ -0,0 +1,126 @@
+// iui_startup_report — print the cold-start waterfall, with deltas.
+//
+// Usage: iui_startup_report <trace.jsonl> [baseline.jsonl]
+//
+// The trace comes from iui_startup_write; the optional baseline is an
+// earlier trace from the same app (commit one per bundle release).
+// Phases are matched by name, first occurrence wins, so a reordered
+// startup still compares the right pairs.  Ships with the bundles so
+// field machines can verify a startup fix without extra tooling.
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct phase {
+    std::string name;
+    uint64_t t_us;
+    uint64_t dt_us;
+};
+
+// Same minimal flat-JSON scanning as the trace converter: the writer is
+// ours, so a full parser buys nothing.
+bool parse_line(const char *line, phase &out) {
+    const char *p = strstr(line, "\"phase\":\"");
+    if (!p)
+        return false;
+    p += 9;
+    const char *end = strchr(p, '"');
+    if (!end)
+        return false;
+    out.name.assign(p, end);
+    p = strstr(line, "\"t_us\":");
+    if (!p)
+        return false;
+    out.t_us = strtoull(p + 7, nullptr, 10);
+    p = strstr(line, "\"dt_us\":");
+    if (!p)
+        return false;
+    out.dt_us = strtoull(p + 8, nullptr, 10);
+    return true;
+}
+
+bool load(const char *path, std::vector<phase> &out) {
+    FILE *f = fopen(path, "rb");
+    if (!f)
+        return false;
+    char line[512];
+    while (fgets(line, sizeof(line), f)) {
+        phase ph;
+        if (parse_line(line, ph))
+            out.push_back(ph);
+    }
+    fclose(f);
+    return true;
+}
+
+const phase *find(const std::vector<phase> &phases, const std::string &name) {
+    for (const phase &p : phases)
+        if (p.name == name)
+            return &p;
+    return nullptr;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    if (argc != 2 && argc != 3) {
+        fprintf(stderr, "usage: %s <trace.jsonl> [baseline.jsonl]\n",
+                argv[0]);
+        return 2;
+    }
+    std::vector<phase> trace, baseline;
+    if (!load(argv[1], trace) || trace.empty()) {
+        fprintf(stderr, "error: cannot read trace %s\n", argv[1]);
+        return 1;
+    }
+    bool have_base = argc == 3;
+    if (have_base && !load(argv[2], baseline)) {
+        fprintf(stderr, "error: cannot read baseline %s\n", argv[2]);
+        return 1;
+    }
+
+    uint64_t total = trace.back().t_us;
+    uint64_t max_dt = 1;
+    for (const phase &p : trace)
+        if (p.dt_us > max_dt)
+            max_dt = p.dt_us;
+
+    printf("%-24s %9s %9s", "phase", "start", "dur");
+    if (have_base)
+        printf(" %9s %9s", "base", "delta");
+    printf("  waterfall\n");
+    for (const phase &p : trace) {
+        printf("%-24s %7.1fms %7.1fms", p.name.c_str(),
+               (double)p.t_us / 1000.0, (double)p.dt_us / 1000.0);
+        if (have_base) {
+            const phase *b = find(baseline, p.name);
+            if (b) {
+                double delta =
+                    ((double)p.dt_us - (double)b->dt_us) / 1000.0;
+                printf(" %7.1fms %+7.1fms", (double)b->dt_us / 1000.0,
+                       delta);
+            } else {
+                printf(" %9s %9s", "-", "new");
+            }
+        }
+        int bar = (int)((p.dt_us * 40 + max_dt - 1) / max_dt);
+        printf("  %*s", (int)((p.t_us * 40) / (total ? total : 1)), "");
+        for (int i = 0; i < bar; ++i)
+            putchar('#');
+        putchar('\n');
+    }
+    printf("%-24s %9s %7.1fms", "total", "",
+           (double)total / 1000.0);
+    if (have_base && !baseline.empty()) {
+        uint64_t base_total = baseline.back().t_us;
+        printf(" %7.1fms %+7.1fms", (double)base_total / 1000.0,
+               ((double)total - (double)base_total) / 1000.0);
+    }
+    putchar('\n');
+    return 0;
+}
@@ -0,0 +1,169 @@
+// iui_trace_convert — convert a requests.jsonl event log to an IUIT trace.
+//
+// Usage: iui_trace_convert <in.jsonl> <out.iuit>
+//
+// One JSON object per line; recognised keys are "type" (string or number),
+// "device", "time_us", "x", "y", "dx", "dy", "code" and "frame".  Unknown
+// keys are ignored so captures can carry extra annotation.  The parser is
+// deliberately minimal: flat objects, numeric values, no escapes inside the
+// type name — which is all the capture format ever emits.
+
+#include "iui/trace.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+namespace {
+
+struct type_name {
+    const char *name;
+    iui_event_type type;
+};
+
+const type_name kTypeNames[] = {
+    {"mouse_move", IUI_EVENT_MOUSE_MOVE}, {"mouse_down", IUI_EVENT_MOUSE_DOWN},
+    {"mouse_up", IUI_EVENT_MOUSE_UP},     {"scroll", IUI_EVENT_SCROLL},
+    {"key_down", IUI_EVENT_KEY_DOWN},     {"key_up", IUI_EVENT_KEY_UP},
+    {"text", IUI_EVENT_TEXT},             {"touch_down", IUI_EVENT_TOUCH_DOWN},
+    {"touch_move", IUI_EVENT_TOUCH_MOVE}, {"touch_up", IUI_EVENT_TOUCH_UP},
+    {"frame_mark", IUI_EVENT_FRAME_MARK},
+};
+
+iui_event_type type_from_name(const char *name, size_t len) {
+    for (const type_name &t : kTypeNames) {
+        if (strlen(t.name) == len && memcmp(t.name, name, len) == 0)
+            return t.type;
+    }
+    return IUI_EVENT_NONE;
+}
+
+const char *skip_ws(const char *p) {
+    while (*p == ' ' || *p == '\t')
+        ++p;
+    return p;
+}
+
+// Parse one {"key": value, ...} line into an event.  Returns false for
+// blank/garbage lines, which the converter skips with a warning.
+bool parse_line(const char *line, iui_event *e) {
+    *e = iui_event{};
+    const char *p = skip_ws(line);
+    if (*p != '{')
+        return false;
+    ++p;
+    bool saw_type = false;
+    for (;;) {
+        p = skip_ws(p);
+        if (*p == '}' || *p == '\0')
+            break;
+        if (*p == ',') {
+            ++p;
+            continue;
+        }
+        if (*p != '"')
+            return false;
+        const char *key = ++p;
+        const char *key_end = strchr(p, '"');
+        if (!key_end)
+            return false;
+        size_t key_len = (size_t)(key_end - key);
+        p = skip_ws(key_end + 1);
+        if (*p != ':')
+            return false;
+        p = skip_ws(p + 1);
+
+        if (*p == '"') {
+            const char *val = ++p;
+            const char *val_end = strchr(p, '"');
+            if (!val_end)
+                return false;
+            if (key_len == 4 && memcmp(key, "type", 4) == 0) {
+                e->type = (uint32_t)type_from_name(val, (size_t)(val_end - val));
+                saw_type = true;
+            }
+            p = val_end + 1;
+            continue;
+        }
+
+        char *num_end = nullptr;
+        double v = strtod(p, &num_end);
+        if (num_end == p)
+            return false;
+        if (key_len == 4 && memcmp(key, "type", 4) == 0) {
+            e->type = (uint32_t)v;
+            saw_type = true;
+        } else if (key_len == 6 && memcmp(key, "device", 6) == 0) {
+            e->device = (uint32_t)v;
+        } else if (key_len == 7 && memcmp(key, "time_us", 7) == 0) {
+            e->time_us = (uint64_t)v;
+        } else if (key_len == 1 && key[0] == 'x') {
+            e->x = (float)v;
+        } else if (key_len == 1 && key[0] == 'y') {
+            e->y = (float)v;
+        } else if (key_len == 2 && memcmp(key, "dx", 2) == 0) {
+            e->dx = (float)v;
+        } else if (key_len == 2 && memcmp(key, "dy", 2) == 0) {
+            e->dy = (float)v;
+        } else if (key_len == 4 && memcmp(key, "code", 4) == 0) {
+            e->code = (uint32_t)v;
+        } else if (key_len == 5 && memcmp(key, "frame", 5) == 0) {
+            e->frame = (uint32_t)v;
+        }
+        p = num_end;
+    }
+    return saw_type;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    if (argc != 3) {
+        fprintf(stderr, "usage: %s <in.jsonl> <out.iuit>\n", argv[0]);
+        return 2;
+    }
+    FILE *in = fopen(argv[1], "rb");
+    if (!in) {
+        fprintf(stderr, "error: cannot read %s\n", argv[1]);
+        return 1;
+    }
+    iui_trace_writer *w = iui_trace_writer_open(argv[2]);
+    if (!w) {
+        fprintf(stderr, "error: cannot write %s\n", argv[2]);
+        fclose(in);
+        return 1;
+    }
+
+    char line[4096];
+    uint64_t converted = 0, skipped = 0, line_no = 0;
+    while (fgets(line, sizeof(line), in)) {
+        ++line_no;
+        const char *p = skip_ws(line);
+        if (*p == '\0' || *p == '\n')
+            continue;
+        iui_event e;
+        if (!parse_line(line, &e)) {
+            fprintf(stderr, "warning: line %llu: not an event record\n",
+                    (unsigned long long)line_no);
+            ++skipped;
+            continue;
+        }
+        if (iui_trace_write(w, &e) != IUI_OK) {
+            fprintf(stderr, "error: write failed at line %llu\n",
+                    (unsigned long long)line_no);
+            fclose(in);
+            iui_trace_writer_close(w);
+            return 1;
+        }
+        ++converted;
+    }
+    fclose(in);
+    if (iui_trace_writer_close(w) != IUI_OK) {
+        fprintf(stderr, "error: finalizing %s failed\n", argv[2]);
+        return 1;
+    }
+    printf("%s: %llu events converted, %llu lines skipped\n", argv[2],
+           (unsigned long long)converted, (unsigned long long)skipped);
+    return 0;
+}